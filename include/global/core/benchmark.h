@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// forward declaration
+struct runtime_config;
+struct test_result;
+
+// the solution is run on each accepted test a few times more,
+// statistics of the measured runs are printed as CSV
+namespace benchmark {
+
+    // measured runs of a single test
+    struct sample {
+        uint32_t id = 0;
+        uint32_t seed = 0;
+        std::vector<size_t> times;    // ms
+        std::vector<size_t> memories; // bytes
+    };
+
+    sample measure(test_result const &);
+
+    // min, median, p90, p99, mean, standard deviation and 95% confidence
+    // interval of the mean, of time and memory of each test
+    std::string report(runtime_config const &, std::vector<sample> const &);
+}
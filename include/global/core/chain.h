@@ -0,0 +1,50 @@
+#pragma once
+
+#include "units/unit.h"
+#include <vector>
+#include <memory>
+
+// forward declaration
+struct runtime_config;
+struct test_result;
+
+class memory_budget;
+
+namespace units {
+    class generator;
+}
+
+// sequence of units each test goes through
+class chain {
+public:
+    chain(runtime_config &, memory_budget &);
+
+    // run the test through units until error happened,
+    // then the source of tests learns of the result
+    void run(runtime_config &, test_result &) const;
+
+    // run the solution again on the accepted test to measure it
+    void bench(runtime_config &, test_result &) const;
+
+    // run variants of the solution on the accepted test and check them
+    void compare(runtime_config &, test_result &) const;
+
+    // only make the test
+    void generate(runtime_config &, test_result &) const;
+
+    // run the test which is made already
+    void check(runtime_config &, test_result &) const;
+
+    // only check the outputs which are made already
+    void verify(runtime_config &, test_result &) const;
+
+private:
+    void run(runtime_config &, test_result &, size_t first, size_t last) const;
+
+    std::vector<std::shared_ptr<units::unit>> u;
+    std::shared_ptr<units::unit> toTest;
+    std::shared_ptr<units::unit> verifier;
+    std::vector<std::shared_ptr<units::unit>> variants;
+    std::shared_ptr<units::generator> source;
+    memory_budget &budget;
+};
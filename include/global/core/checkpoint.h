@@ -0,0 +1,32 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+
+// forward declaration
+struct runtime_config;
+
+// state of session, which is enough to continue it later
+struct checkpoint {
+    using path = std::filesystem::path;
+
+    uint32_t initialSeed = 0;
+    uint32_t testsCompleted = 0; // all the tests started before are done
+    uint64_t totalTime = 0;
+    uint64_t maxTime = 0;
+    bool solutionBroken = false;
+
+    // what has been logged before
+    path logPath;
+    uint64_t logSize = 0;
+
+    // where checkpoint of the session is stored
+    static path location(runtime_config const &);
+
+    // throws if it is missing or made for another session
+    static checkpoint load(runtime_config const &);
+
+    bool save(runtime_config const &) const;
+
+    static void remove(runtime_config const &);
+};
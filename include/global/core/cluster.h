@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// forward declaration
+struct runtime_config;
+struct session;
+
+namespace cluster {
+
+    // hand tests out to remote workers until the session is over
+    void serve(runtime_config const &, session &);
+
+    // connect to the coordinator and run tests it gives
+    void join(runtime_config &, uint32_t workersCount);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// forward declaration
+struct runtime_config;
+struct test_result;
+
+// growth of time and memory with size of tests, sizes are passed
+// to generator after the seed and go up geometrically
+namespace complexity {
+
+    // time and memory of a single test
+    struct measurement {
+        uint64_t size = 0;
+        size_t time = 0;
+        size_t memory = 0;
+        size_t primeTime = 0;
+        size_t primeMemory = 0;
+    };
+
+    // sizes from lo to hi, each one is twice the previous
+    std::vector<uint64_t> sizes(uint64_t lo, uint64_t hi);
+
+    // tests of a size go in a row
+    uint64_t testSize(runtime_config const &, uint32_t testId);
+
+    measurement measure(runtime_config const &, test_result const &);
+
+    // table of medians by size with curves, and the best fitting
+    // of O(1), O(log n), O(n), O(n log n), O(n^2), O(n^2 log n), O(n^3), O(2^n)
+    std::string report(runtime_config const &, std::vector<measurement> const &);
+}
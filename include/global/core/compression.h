@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// tests may be stored compressed, format is known by magic bytes
+namespace compression {
+    enum class format {
+        NONE,
+        GZIP,
+        ZSTD
+    };
+
+    format detect(std::string_view data);
+
+    // decompressed data is appended, false if it is broken or format is not supported by this build
+    bool decompress(std::string_view data, std::string &out, std::string &error);
+}
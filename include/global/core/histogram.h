@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// distribution of time or memory of all the tests, values are counted in buckets
+// which are exact for small values and grow geometrically like in HDR histograms,
+// so memory is bounded however many tests are run
+namespace histogram {
+
+    class distribution {
+    public:
+        void add(uint64_t value);
+
+        uint64_t count() const { return total; }
+
+        uint64_t max() const { return maximum; }
+
+        // the least value which is not exceeded by the given share of values,
+        // up to precision of buckets
+        uint64_t percentile(double share) const;
+
+        // counts of values from 2^(i-1) to 2^i - 1, the first one is of zeros,
+        // starting from the one of the least value
+        std::vector<std::pair<uint64_t, uint64_t>> octaves() const;
+
+    private:
+        std::vector<uint64_t> buckets; // up to the one of the maximum
+        uint64_t total = 0;
+        uint64_t minimum = UINT64_MAX;
+        uint64_t maximum = 0;
+    };
+
+    // percentiles and a chart by powers of two, of time in ms or memory in bytes
+    std::string report(std::string const &title, distribution const &, bool memory);
+}
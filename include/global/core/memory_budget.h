@@ -0,0 +1,42 @@
+#pragma once
+
+#include "units/unit.h"
+#include <condition_variable>
+#include <mutex>
+#include <cstdint>
+
+// forward declaration
+struct runtime_config;
+struct test_result;
+
+// admission control of concurrent executions by their memory usage
+class memory_budget {
+public:
+    explicit memory_budget(runtime_config const &);
+
+    // wait until execution of the unit fits into budget,
+    // returns count of reserved bytes
+    uint64_t acquire(units::unit const &);
+
+    // free reservation and remember how much was really used
+    void release(units::unit const &, uint64_t reserved, test_result const &);
+
+    // memory needed by a single test if limits are set, otherwise zero
+    static uint64_t testEstimate(runtime_config const &);
+
+private:
+    // if unit runs a process
+    bool accountable(units::unit const &) const;
+
+    // limit of unit or the highest peak observed
+    uint64_t estimate(units::unit const &) const;
+
+    runtime_config const &cfg;
+    uint64_t budget;
+    uint64_t used = 0;
+    uint64_t peaks[units::UNIT_CATEGORIES] = {}; // by unit category
+    uint64_t buffers = 0;   // the largest test_result seen
+
+    std::mutex mutex;
+    std::condition_variable cond;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+// forward declaration
+struct runtime_config;
+struct session;
+
+class memory_budget;
+
+namespace multitest {
+
+    // take tests by groups, run each group as a single input
+    // with count of tests on the first line, unless it's disabled
+    void worker(runtime_config &, session &, memory_budget &);
+}
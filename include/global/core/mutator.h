@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/runtime_config.h"
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <mutex>
+#include <cstdint>
+
+// forward declaration
+struct test_result;
+
+// tests made by a few random changes of the known ones: numbers are
+// perturbed, tokens are spliced from other tests, lines are repeated
+// or dropped. Tests which make the solution behave in a new way are
+// known from then on, so they are changed as well.
+// In search of the worst case, only the hardest tests are known,
+// and harder ones are changed more often
+class mutator {
+public:
+    explicit mutator(worst_case worst = worst_case::NONE) : worst(worst) {}
+
+    // known test to start with
+    void add(std::string test);
+
+    bool empty() const;
+
+    // test made from a known one, different attempts make different tests
+    std::string mutate(uint32_t seed, uint32_t attempt) const;
+
+    // known test as is
+    std::string original(uint32_t seed) const;
+
+    // keep the test if its verdict, time, memory or size of output
+    // is not seen before, or if it's one of the hardest, true if it's kept
+    bool learn(test_result const &);
+
+private:
+    bool select(test_result const &);
+
+    worst_case worst;
+    mutable std::mutex mutex;
+    std::vector<std::string> corpus;
+    std::vector<size_t> fitness; // of each known test, zero if it's not run
+    size_t corpusBytes = 0;
+    std::unordered_set<uint64_t> behaviours;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <cstdint>
+
+// forward declaration
+struct execution_result;
+
+// outputs of a program stored on disk by content of the program and input,
+// so they are reused by the next sessions
+class output_cache {
+public:
+    using path = std::filesystem::path;
+
+    // throws if cache directory can't be created
+    explicit output_cache(path const &program);
+
+    // false if the input is not cached
+    bool load(std::string const &input, std::string &output, execution_result &) const;
+
+    bool store(std::string const &input, std::string const &output, execution_result const &) const;
+
+private:
+    path entry(std::string const &input) const;
+
+    path dir;
+};
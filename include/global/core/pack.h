@@ -0,0 +1,66 @@
+#pragma once
+
+#include "mapped_file.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <cstdint>
+
+// pack is a file of generated tests:
+// header, inputs one after another, index of tests sorted by id, footer
+namespace pack {
+    using path = std::filesystem::path;
+
+    struct entry {
+        uint32_t id = 0;
+        uint32_t seed = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    // FNV-1a of the data, may be continued from the hash of preceding data
+    uint64_t hash(std::string_view, uint64_t seed = 0xcbf29ce484222325ull);
+
+    // FNV-1a of the file content, zero if it can't be read
+    uint64_t fileHash(path const &);
+
+    // hash as 16 hex digits
+    std::string hex(uint64_t);
+
+    class writer {
+    public:
+        // throws if file can't be created
+        writer(path const &, uint64_t generatorHash);
+
+        bool write(uint32_t id, uint32_t seed, std::string const &input);
+
+        // index is written on destruction
+        ~writer();
+
+    private:
+        std::ofstream out;
+        std::vector<entry> index;
+        uint64_t offset = 0;
+    };
+
+    class reader {
+    public:
+        // false if it is not a pack
+        bool open(path const &);
+
+        // the position-th test in order of ids, false if there is no such test
+        bool read(uint32_t position, std::string &input, uint32_t &seed) const;
+
+        size_t size() const {
+            return index.size();
+        }
+
+        uint64_t generatorHash = 0;
+
+    private:
+        mapped_file mapping;
+        std::vector<entry> index;
+    };
+}
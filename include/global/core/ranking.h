@@ -0,0 +1,27 @@
+#pragma once
+
+#include "core/run.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// forward declaration
+struct runtime_config;
+
+// variants of the solution run on the same tests,
+// their time is compared with the time of the solution
+namespace ranking {
+
+    // runs of the solution and its variants on a single test
+    struct sample {
+        uint32_t id = 0;
+        size_t time = 0;
+        std::vector<variant_result> variants;
+    };
+
+    sample measure(test_result const &);
+
+    // time ratios by test, then variants ranked by geometric mean of ratios
+    // with counts of wins and p-value of Wilcoxon signed-rank test
+    std::string report(runtime_config const &, std::vector<sample> const &);
+}
@@ -1,13 +1,15 @@
 #pragma once
 
 #include <string>
-#include "session.h"
+#include <vector>
+#include <cstdint>
 
 class verdict {
 public:
     enum value {
         NOT_TESTED,
         SKIPPED,
+        DUPLICATE,
         TESTS_OVER,
         TESTS_READ_ERROR,
         GENERATOR_FAILED,
@@ -63,10 +65,23 @@ struct error_info;
 
 struct execution_error {
 
+    execution_error() = default;
+
+    execution_error(execution_error const&) = delete;
+
+    execution_error(execution_error &&) noexcept;
+
+    execution_error& operator=(execution_error const&) = delete;
+
+    execution_error& operator=(execution_error &&) noexcept;
+
     void storeErrCode(size_t code);
 
     void storeExitCode(size_t code);
 
+    // error happened elsewhere (e.g. on a remote worker)
+    void storeExplanation(std::string expl);
+
     // os-dependent
     void storeErrInfo(error_info const&);
 
@@ -84,6 +99,7 @@ private:
     error_info* info = nullptr;
     size_t exitCode = 0;
     size_t errCode = 0;
+    std::string explanation;
 
     // os-dependent
     std::string errInfoExplanation() const;
@@ -98,14 +114,38 @@ struct execution_result {
     execution_error error;
 };
 
+// run of a variant of the solution on the same test
+struct variant_result {
+    verdict verdict;
+    size_t time = 0;
+    size_t memory = 0;
+};
+
 struct test_result {
-    decltype(session::rand.operator()()) seed;
+    uint32_t ordinal = 0; // order of starting, assigned by session
+    uint32_t id = 0; // test index, assigned by session
+    uint32_t seed = 0;
     execution_result execResult;
     verdict verdict;
     std::string input;
     std::string output;
     std::string output2;
     std::string err;
+    uint64_t inputHash = 0; // if duplicates are skipped
+
+    // of the solution to test, the next units overwrite execResult
+    size_t solutionTime = 0;
+    size_t solutionMemory = 0;
+    size_t primeTime = 0;
+    size_t primeMemory = 0;
+    size_t timeLimit = 0; // of the solution on this test, if it's relative to prime
+
+    // measured runs of the solution when it's benchmarked
+    std::vector<size_t> benchTimes;
+    std::vector<size_t> benchMemories;
+
+    // of each variant of the solution, in order of their options
+    std::vector<variant_result> variants;
 
     void clear();
 };
@@ -2,6 +2,8 @@
 #include <filesystem>
 #include <unordered_set>
 #include <unordered_map>
+#include <optional>
+#include <vector>
 #include "units/unit.h"
 #include "tests_source.h"
 
@@ -15,18 +17,54 @@ struct limits {
     uint32_t memoryLimit = 0;      // bytes
     uint32_t primeTimeLimit = 0;   // ms
     uint32_t primeMemoryLimit = 0; // bytes
+    double relativeTimeLimit = 0;  // of prime time on the same test
+    uint32_t timeLimitFloor = 100; // ms, of relative time limit
+};
+
+// what tests are searched for
+enum class worst_case {
+    NONE,
+    TIME,
+    MEMORY
+};
+
+struct replay_entry {
+    uint32_t id = 0;
+    std::optional<uint32_t> seed; // if not set, derived from id
 };
 
 struct generator_config {
     uint32_t initialSeed = 0;
     tests_source testsSource = tests_source::UNSPECIFIED;
+    std::vector<replay_entry> replay;
+    std::filesystem::path recordPath; // pack of generated tests
+    uint32_t batchSize = 1; // tests made by a single generator run
+    bool watch = false; // wait for new files in directory of tests
+    bool dedup = false; // skip tests with inputs seen before
+    std::filesystem::path corpusPath; // hashes of inputs seen by previous sessions
+    worst_case worst = worst_case::NONE; // tests which are the hardest for the solution
+    std::vector<uint64_t> sizes; // passed to generator after seed to estimate complexity
+    uint32_t sizeRepeats = 0; // tests of each size
 };
 
 struct invoker_config {
     uint32_t testsCount = 10;
     uint32_t workersCount = 0;
+    uint32_t shardIndex = 0;  // zero-based
+    uint32_t shardsCount = 1;
+    uint64_t memoryBudget = 0; // bytes, shared by all the executions
+    std::string serveAddress; // coordinator of cluster
+    std::string joinAddress;  // worker of cluster
     std::unordered_set<units::unit_category> useCached;
     bool multithreading = false;
+    uint32_t multitestSize = 1; // tests run as a single input
+    bool multitestCount = true; // count of tests on the first line of a group
+    std::optional<std::string> multitestSeparator; // line between outputs of tests in a group
+    bool resume = false;      // continue from the checkpoint
+    bool shrink = false;      // minimize the first failed test
+    uint32_t benchRuns = 0;   // measured runs of the solution on each test
+    uint32_t warmupRuns = 1;  // runs before the measured ones, including the checked run
+    std::optional<uint32_t> pinnedCore; // of the solution
 };
 
 struct terminal_config {
@@ -49,19 +87,24 @@ struct runtime_config : limits, generator_config, invoker_config, terminal_confi
     using path = std::filesystem::path;
 
     bool ignorePRE = false;
+    bool primeCache = false; // reuse outputs of prime from previous sessions
 
     units::proto_unit generator;
     units::proto_unit toTest;
     units::proto_unit prime;
     units::proto_unit verifier;
+    units::proto_unit validator; // of tests made by mutations
+    std::vector<units::proto_unit> variants; // of solution to test, compared with it
 
     std::unordered_map<
             units::unit_category,
             std::shared_ptr<units::unit>> units;
+    std::vector<std::shared_ptr<units::unit>> variantUnits;
 
     runtime_config() :
             generator(units::unit_category::GENERATOR),
             toTest(units::unit_category::TO_TEST),
             prime(units::unit_category::PRIME),
-            verifier(units::unit_category::VERIFIER) {}
+            verifier(units::unit_category::VERIFIER),
+            validator(units::unit_category::VALIDATOR) {}
 };
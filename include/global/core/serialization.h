@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+
+// little-endian serialization
+struct packer {
+    std::string data;
+
+    template<typename T>
+    void put(T value) {
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            data += (char) (((uint64_t) value >> (8 * i)) & 0xff);
+        }
+    }
+
+    void put(std::string const &s) {
+        put((uint32_t) s.size());
+        data += s;
+    }
+};
+
+struct unpacker {
+    std::string_view data;
+    size_t pos = 0;
+
+    template<typename T>
+    T get() {
+        if (data.size() - pos < sizeof(T)) {
+            throw std::runtime_error("[!] Malformed data");
+        }
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value |= (uint64_t) (unsigned char) data[pos + i] << (8 * i);
+        }
+        pos += sizeof(T);
+        return (T) value;
+    }
+
+    std::string getString() {
+        auto size = get<uint32_t>();
+        if (data.size() - pos < size) {
+            throw std::runtime_error("[!] Malformed data");
+        }
+        pos += size;
+        return std::string(data.substr(pos - size, size));
+    }
+};
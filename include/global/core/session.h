@@ -1,7 +1,22 @@
 #pragma once
 
 #include "units/generator.h"
-#include <random>
+#include "core/run.h"
+#include "core/checkpoint.h"
+#include "core/pack.h"
+#include "core/complexity.h"
+#include "core/benchmark.h"
+#include "core/ranking.h"
+#include "core/histogram.h"
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
 
 // forward declaration
 struct runtime_config;
@@ -11,25 +26,112 @@ class terminal;
 class logger;
 
 struct session {
+    // slowest and most memory-hungry tests reported with stats
+    static constexpr size_t LEADERBOARD_TESTS = 10;
+
     uint64_t totalTime = 0;
     uint64_t maxTime = 0;
     uint32_t testsStarted = 0;
     uint32_t testsDone = 0;
+    uint32_t duplicates = 0;
 
     runtime_config const &cfg;
     logger &logger;
-    std::mt19937 rand;
     std::mutex mutex;
 
     bool solutionBroken = false;
     bool cancelled = false; // if cancelled() -> terminal.interrupted()
 
-    session(runtime_config &, class logger &);
+    // kept for shrinking, the first ordinary error in order of tests
+    std::optional<test_result> firstFailure;
+
+    // the hardest tests for the solution, the hardest is the first
+    std::vector<test_result> worstTests;
+
+    // leaderboards of the checked tests if stats are displayed, unless
+    // the same is searched for as the worst case
+    std::vector<test_result> slowestTests;
+    std::vector<test_result> hungriestTests;
+
+    // time and memory of the checked tests if stats are displayed
+    histogram::distribution solutionTimes;
+    histogram::distribution solutionMemories;
+    histogram::distribution primeTimes;
+    histogram::distribution primeMemories;
+
+    // time and memory of tests by size to estimate complexity
+    std::vector<complexity::measurement> measurements;
+
+    // measured runs of the solution on each accepted test
+    std::vector<benchmark::sample> benchmarks;
+
+    // runs of variants of the solution on each accepted test
+    std::vector<ranking::sample> comparisons;
 
-    bool newTest(decltype(rand.operator()()) &seed);
+    session(runtime_config &, class logger &, uint32_t workersCount);
 
+    // assign the next test index and seed,
+    // without waiting fails if there is no test to start right now
+    bool newTest(test_result &, bool wait = true);
+
+    // results are emitted in order of starting
     void processedTest(test_result &);
 
+    // test was not done, give it to someone else
+    void returnTest(test_result const &);
+
+    // all the tests are done or session is cancelled
+    bool finished();
+
+    // continue from the checkpoint of a previous session
+    void restore(checkpoint const &);
+
+    // store checkpoint if there is something left to do
+    void finish();
+
+    // count of tests which belong to the shard
+    static uint32_t shardTestsCount(runtime_config const &);
+
+    // index of the test which is started ordinal-th
+    static uint32_t testId(runtime_config const &, uint32_t ordinal);
+
+    // seed of the test which is started ordinal-th
+    static uint32_t testSeed(runtime_config const &, uint32_t ordinal);
+
+    // counter-based, so any test can be reproduced alone
+    static uint32_t deriveSeed(uint32_t initialSeed, uint32_t testId);
+
 private:
+    void emit(test_result &);
+
+    // in order of tests, so the first one with an input is never a duplicate
+    bool isDuplicate(test_result const &);
+
+    void loadCorpus();
+
+    // the hardest ones of the given kind are the first, at most limit of them
+    static void keepWorst(std::vector<test_result> &, test_result const &, worst_case, size_t limit);
+
+    void storeCheckpoint();
+
     void cancel();
-};
\ No newline at end of file
+
+    // results which are done, but wait for the preceding ones
+    std::map<uint32_t, test_result> reorderBuffer;
+    std::condition_variable reorderCond;
+    uint32_t reorderWindow;
+
+    std::set<uint32_t> returnedTests;
+    uint32_t testsInFlight = 0;
+    uint32_t testsEmitted = 0;
+    uint32_t testsCompleted = 0; // without interrupted and critical errors
+    uint32_t testsLimit;
+
+    std::chrono::steady_clock::time_point lastCheckpoint = std::chrono::steady_clock::now();
+
+    std::unique_ptr<pack::writer> recorder;
+
+    // hashes of inputs of the emitted tests and of previous sessions
+    std::unordered_set<uint64_t> seenInputs;
+    std::ofstream corpus;
+};
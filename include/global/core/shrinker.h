@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// forward declaration
+struct runtime_config;
+struct test_result;
+
+class memory_budget;
+
+namespace shrinker {
+
+    // make the input of the failed test smaller, so it still fails
+    // with the same verdict: drop lines, then tokens, then make numbers
+    // closer to zero. Candidates are checked by workers in parallel.
+    // False if nothing smaller is found
+    bool shrink(runtime_config &, memory_budget &, uint32_t workersCount, test_result &);
+}
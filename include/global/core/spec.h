@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// declarative description of tests, each statement is on its own line:
+//
+//   n = int 1 10         variable with a random value
+//   line n perm n        line of space-separated items
+//   tree n               n-1 edges of a random tree
+//   graph n m            m edges of a random simple graph, n < 2^32
+//   repeat n ... end     statements repeated n times
+//
+// items are numbers, variables, "int lo hi", "array len lo hi",
+// "perm n" and "string len alphabet" (e.g. "a-z0-9")
+class spec {
+public:
+    using path = std::filesystem::path;
+
+    // throws if the spec is malformed
+    static spec parse(path const &);
+
+    // false if the test can't be made, e.g. range is empty
+    bool generate(uint32_t seed, std::string &test, std::string &error) const;
+
+    // operand of an item, a number or a variable
+    struct atom {
+        bool variable = false;
+        int64_t value = 0; // or index of variable
+    };
+
+    struct item {
+        enum class kind {
+            VALUE, INT, ARRAY, PERM, STRING
+        };
+
+        kind k = kind::VALUE;
+        std::vector<atom> args;
+        std::string alphabet;
+    };
+
+    struct statement {
+        enum class kind {
+            ASSIGN, LINE, TREE, GRAPH, REPEAT
+        };
+
+        kind k = kind::LINE;
+        size_t variable = 0;
+        std::vector<item> items;
+        std::vector<atom> args;
+        std::vector<statement> body;
+    };
+
+private:
+    std::vector<statement> statements;
+    size_t variablesCount = 0;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "mapped_file.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+// tar archive mapped into memory, regular files are indexed once
+class tar_archive {
+public:
+    struct member {
+        std::string name;
+        std::string_view data;
+    };
+
+    // false if it is not a tar archive or it is broken
+    bool open(std::filesystem::path const &);
+
+    std::vector<member> members;
+
+private:
+    mapped_file mapping;
+};
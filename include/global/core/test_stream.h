@@ -0,0 +1,30 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+// tests read from stdin or a pipe as they arrive, not far ahead of workers
+class test_stream {
+public:
+    using path = std::filesystem::path;
+
+    // "-" is stdin, tests which don't belong to the shard are dropped
+    test_stream(path const &, uint32_t shardIndex, uint32_t shardsCount);
+
+    test_stream(test_stream const &) = delete;
+
+    test_stream &operator=(test_stream const &) = delete;
+
+    // wait for the test, false if the stream is over or session is interrupted
+    bool take(uint32_t id, std::string &test);
+
+    ~test_stream();
+
+private:
+    struct state;
+
+    // reader may block on the pipe forever, so it is detached and owns the state too
+    std::shared_ptr<state> s;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+
+// splitting of a file of tests, which is the same for a mapped file and a stream
+namespace tests_file {
+
+    // tests are separated by two or more line breaks (\n, \r or \r\n),
+    // returns the test which begins at pos or later, empty if there are no more
+    std::string_view nextTest(std::string_view data, size_t &pos);
+}
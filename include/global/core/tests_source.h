@@ -4,5 +4,14 @@ enum class tests_source {
     UNSPECIFIED,
     EXECUTABLE,
     FILE,
-    DIR
+    DIR,
+    PACK,
+    PLUGIN,
+    SPEC,
+    MUTATE
 };
+
+// tests are made by seeds, so they can be replayed by seeds
+constexpr bool isSeeded(tests_source s) {
+    return s == tests_source::EXECUTABLE || s == tests_source::PLUGIN || s == tests_source::SPEC;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+#include <cstdint>
+
+// notifies about files written to the directory
+class dir_watcher {
+public:
+    using path = std::filesystem::path;
+
+    // throws if directory can't be watched
+    explicit dir_watcher(path const &dir);
+
+    dir_watcher(dir_watcher const &) = delete;
+
+    dir_watcher &operator=(dir_watcher const &) = delete;
+
+    // wait no longer than timeout, append files which are completely written since the last call
+    bool wait(std::vector<path> &created, uint32_t timeoutMs);
+
+    ~dir_watcher();
+
+private:
+    path dir;
+    intptr_t handle = -1;
+};
@@ -56,9 +56,10 @@ namespace invoker {
     using comp_rule_ctor = std::pair<std::string, comp_variant>;
     using comp_rules = std::unordered_map<std::string, comp_variant>;
 
-    // compiled expressions aliases
-    using exec_commands = std::unordered_map<units::unit_category, command>;
-    using comp_commands = std::unordered_map<units::unit_category, comp_rule>;
+    // compiled expressions aliases, by path of unit,
+    // as there may be a few units of a category
+    using exec_commands = std::unordered_map<std::string, command>;
+    using comp_commands = std::unordered_map<std::string, comp_rule>;
 
     // for example:
     // ".exe" and ".bat" on Windows
@@ -127,6 +128,9 @@ namespace invoker {
     // compile unit
     bool compile(runtime_config const &, units::unit &);
 
+    // os-specific id of the stress process itself
+    uint64_t processId();
+
     namespace utils {
         // os-specific compilation
         bool compile(runtime_config const &, units::unit &, path&&, command const&);
@@ -13,11 +13,25 @@ public:
 
     STATUS writeTest(runtime_config const&cfg, test_result const&, uint32_t, bool = false);
 
+    // minimized input of the failed test, it can't be made by seed
+    STATUS writeShrunkTest(runtime_config const&cfg, test_result const&, uint32_t);
+
+    // one of the hardest tests for the solution
+    STATUS writeWorstTest(runtime_config const&cfg, test_result const&, uint32_t);
+
     static std::string statusExplanation(STATUS);
 
     std::string info();
 
+    // continue the log of a previous session from the given size
+    void resume(std::filesystem::path const &, uint64_t);
+
+    // log file and how much is written, empty if nothing is logged
+    std::pair<std::filesystem::path, uint64_t> position();
+
 private:
+    STATUS write(runtime_config const&cfg, test_result const&, std::string const &title, bool seeded, bool flush);
+
     std::ofstream logFile; // will be closed and freed in dtor
     std::filesystem::path path;
     bool bad = false;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+// read-only view of the whole file
+class mapped_file {
+public:
+    mapped_file() = default;
+
+    mapped_file(mapped_file const &) = delete;
+
+    mapped_file &operator=(mapped_file const &) = delete;
+
+    // false if file couldn't be mapped
+    bool open(std::filesystem::path const &);
+
+    std::string_view view() const {
+        return {data, size};
+    }
+
+    ~mapped_file();
+
+private:
+    char const *data = nullptr;
+    size_t size = 0;
+};
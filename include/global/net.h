@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <optional>
+#include <cstdint>
+
+namespace net {
+    // os-specific socket handle
+    using handle_t = intptr_t;
+
+    // address is "host:port", "port" or "unix:path"
+
+    // connected stream socket
+    class socket {
+    public:
+        socket() = default;
+
+        explicit socket(handle_t h) : handle(h) {}
+
+        socket(socket const &) = delete;
+
+        socket(socket &&s) noexcept: handle(s.release()) {}
+
+        socket &operator=(socket const &) = delete;
+
+        socket &operator=(socket &&) = delete;
+
+        // write the whole buffer
+        bool send(char const *, size_t);
+
+        // read exactly n bytes, false on EOF, error or interruption
+        bool receive(char *, size_t);
+
+        handle_t release();
+
+        ~socket();
+
+    private:
+        handle_t handle = -1;
+    };
+
+    class listener {
+    public:
+        explicit listener(std::string const &address);
+
+        listener(listener const &) = delete;
+
+        listener &operator=(listener const &) = delete;
+
+        // wait for a connection no longer than timeout
+        std::optional<socket> accept(uint32_t timeoutMs);
+
+        ~listener();
+
+    private:
+        handle_t handle = -1;
+        std::string unixPath;
+    };
+
+    // throws if unable to connect
+    socket connect(std::string const &address);
+}
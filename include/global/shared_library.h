@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+// library loaded into the process
+class shared_library {
+public:
+    shared_library() = default;
+
+    shared_library(shared_library const &) = delete;
+
+    shared_library &operator=(shared_library const &) = delete;
+
+    // false if library couldn't be loaded, see error()
+    bool open(std::filesystem::path const &);
+
+    // nullptr if there is no such symbol
+    void *symbol(char const *name) const;
+
+    // explanation of the last failure
+    std::string error() const;
+
+    ~shared_library();
+
+private:
+    void *handle = nullptr;
+};
@@ -2,31 +2,107 @@
 
 #include "unit.h"
 #include "core/tests_source.h"
-#include <fstream>
+#include "mapped_file.h"
+#include "core/pack.h"
+#include "core/spec.h"
+#include "core/mutator.h"
+#include "core/test_stream.h"
+#include "core/tar.h"
+#include "dir_watcher.h"
+#include "shared_library.h"
+#include "generator_plugin.h"
+#include <string_view>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <optional>
+#include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 // forward declaration
 struct test_result;
 
+class memory_budget;
+
 namespace units {
 
 // TODO: tag-dispatching (?)
     class generator : public unit {
         tests_source cat;
-        std::ifstream reader;
-        std::filesystem::directory_iterator iter;
-        std::filesystem::directory_iterator iter_end{};
+        mapped_file mapping;
+        std::string decompressed; // content of compressed file
+        std::vector<std::string_view> tests; // tests in file
+        std::unique_ptr<test_stream> stream; // tests in pipe
+        std::vector<std::filesystem::path> files; // tests in dir
+        std::unique_ptr<tar_archive> archive; // tests in archive instead of dir
+        std::unique_ptr<dir_watcher> watcher; // files which appear in dir later
+        std::set<std::filesystem::path> knownFiles;
+        std::thread watching;
+        pack::reader packReader; // tests in pack
+        shared_library plugin; // tests made in process
+        stress_generate_t pluginGenerate = nullptr;
+        std::optional<spec> testSpec; // tests made by description
+        std::unique_ptr<mutator> mutations; // tests made by changes of known ones
+
+        // tests made by batches, but not taken yet, by ordinal
+        std::map<uint32_t, std::string> generated;
+        std::set<uint32_t> generatingBatches;
+        std::condition_variable batchCond;
+
+        // files are read ahead of workers in order of tests starting
+        std::vector<uint32_t> order;
+        std::map<uint32_t, std::string> prefetched;
+        size_t prefetchedBytes = 0;
+        uint32_t prefetchOrdinal = 0;
+        std::optional<uint32_t> reading;
+        bool stopped = false;
+        std::thread prefetcher;
         std::mutex mutex;
+        std::condition_variable prefetchCond;
+
+        // hashes of inputs made before with ordinal of the first test,
+        // inputs of previous sessions precede all the tests
+        std::unordered_map<uint64_t, int64_t> seen;
+        std::mutex seenMutex;
 
-        bool readNextTestFromFile(std::string &);
-        bool readNextTestFromDir(std::string &);
+        // only the surely duplicate tests are skipped here, the rest is told by session
+        bool isDuplicate(test_result &);
+        void loadCorpus(runtime_config &);
+        bool readTestFromFile(uint32_t, std::string &);
+        bool readTestFromDir(uint32_t, std::string &);
+        bool readCompressed(std::string_view, std::string &) const;
+        bool takeTestFromDir(test_result &);
+        bool takeTestFromWatchedDir(test_result &);
+        void watch();
+        void takeGeneratedTest(runtime_config &, test_result &);
+        void generateBatch(runtime_config &, uint32_t batch, test_result &);
+        bool generate(runtime_config &, std::string const &, test_result &);
+        void generateInProcess(test_result &);
+        void loadMutationSeeds(runtime_config &);
+        void mutate(runtime_config &, test_result &);
+        std::atomic<memory_budget *> validatorBudget = nullptr; // set by chains, the same for all of them
+        void prefetch();
+        bool indexFile();
+        bool indexDir(runtime_config &);
+        void makeOrder(runtime_config &, size_t testsCount);
 
     public:
 
         generator(tests_source testsSource, proto_unit const &u);
 
+        ~generator() override;
+
         bool prepare(runtime_config &cfg) override;
 
         void execute(runtime_config &, test_result &) override;
+
+        // test is done, its input may be worth mutating
+        void learn(test_result const &);
+
+        // validator of mutated tests is run within the budget too
+        void useBudget(memory_budget &);
     };
 }
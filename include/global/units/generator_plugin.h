@@ -0,0 +1,30 @@
+/*
+ * Interface of generator plugins, shared libraries which make tests
+ * inside of stress process. It is plain C, so plugins may include it.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* receives the test by parts */
+struct stress_sink {
+    void *context;
+    void (*write)(void *context, char const *data, size_t size);
+};
+
+/*
+ * Makes the test with the given seed, returns zero on success.
+ * It is called by several threads at once, so it must not share state between calls.
+ */
+typedef int (*stress_generate_t)(uint32_t seed, struct stress_sink const *sink);
+
+#define STRESS_GENERATE_SYMBOL "stress_generate"
+
+#ifdef __cplusplus
+}
+#endif
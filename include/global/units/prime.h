@@ -1,13 +1,25 @@
 #pragma once
 
 #include "unit.h"
+#include "core/output_cache.h"
+#include <memory>
+#include <atomic>
 
 namespace units {
     class prime : public unit {
     public:
         prime(struct proto_unit const& u);
 
+        bool prepare(runtime_config &cfg) override;
+
         void execute(runtime_config &, test_result &) override;
+
+    private:
+        void checkLimits(runtime_config &, test_result &) const;
+
+        // set if outputs of the previous sessions are reused
+        std::unique_ptr<output_cache> cache;
+        std::atomic<bool> caching{true};
     };
 
 }
@@ -14,8 +14,13 @@ namespace units {
         TO_TEST = 1,
         PRIME = 2,
         VERIFIER = 3,
+        VALIDATOR = 4,
     };
 
+    // count of unit categories, the last one is validator
+    constexpr size_t UNIT_CATEGORIES = 5;
+    static_assert((size_t) unit_category::VALIDATOR + 1 == UNIT_CATEGORIES);
+
     struct proto_unit {
         using path = std::filesystem::path;
 
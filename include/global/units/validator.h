@@ -0,0 +1,16 @@
+#pragma once
+
+#include "unit.h"
+
+namespace units {
+
+    // checks tests made by mutations, exit code 0 means the test is valid
+    class validator : public unit {
+
+    public:
+        explicit validator(struct proto_unit const& u);
+
+        // verdict is SKIPPED if the test is not valid
+        void execute(runtime_config &, test_result &) override;
+    };
+}
@@ -0,0 +1,85 @@
+#include "core/benchmark.h"
+#include "core/runtime_config.h"
+#include "core/run.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace {
+    // two-sided 95% quantiles of Student's t-distribution by degrees of freedom
+    constexpr double T_QUANTILES[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    // quantile of the normal distribution, if there are more runs
+    constexpr double Z_QUANTILE = 1.960;
+
+    double tQuantile(size_t freedom) {
+        return freedom <= std::size(T_QUANTILES) ? T_QUANTILES[freedom - 1] : Z_QUANTILE;
+    }
+
+    // nearest-rank percentile of sorted values
+    double percentile(std::vector<double> const &sorted, double p) {
+        auto rank = (size_t) std::ceil(p * (double) sorted.size());
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    void row(std::stringstream &stream, std::string const &prefix, char const *metric, std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        size_t n = values.size();
+
+        double median = n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+        double mean = std::accumulate(values.begin(), values.end(), 0.0) / (double) n;
+        double squares = 0;
+        for (double v: values) {
+            squares += (v - mean) * (v - mean);
+        }
+        double stddev = n > 1 ? std::sqrt(squares / (double) (n - 1)) : 0;
+        double margin = n > 1 ? tQuantile(n - 1) * stddev / std::sqrt((double) n) : 0;
+
+        stream << prefix << metric << ',' << n;
+        for (double v: {values.front(), median, percentile(values, 0.9), percentile(values, 0.99),
+                        mean, stddev, mean - margin, mean + margin}) {
+            stream << ',' << v;
+        }
+        stream << '\n';
+    }
+}
+
+namespace benchmark {
+
+    sample measure(test_result const &result) {
+        sample s;
+        s.id = result.id;
+        s.seed = result.seed;
+        s.times = result.benchTimes;
+        s.memories = result.benchMemories;
+        return s;
+    }
+
+    std::string report(runtime_config const &cfg, std::vector<sample> const &samples) {
+        bool seeded = isSeeded(cfg.testsSource) || cfg.testsSource == tests_source::PACK;
+        std::stringstream stream;
+        stream << std::fixed << std::setprecision(2);
+        stream << '\n' << "[*] Benchmark of " << cfg.benchRuns << " runs after "
+               << cfg.warmupRuns << " warmup runs:" << '\n';
+        stream << "test,seed,metric,runs,min,median,p90,p99,mean,stddev,ci95_low,ci95_high\n";
+
+        for (auto const &s: samples) {
+            std::string prefix = std::to_string(s.id + 1) + ',' + (seeded ? std::to_string(s.seed) : "") + ',';
+
+            std::vector<double> times(s.times.begin(), s.times.end());
+            std::vector<double> memories;
+            for (size_t m: s.memories) {
+                memories.push_back((double) m / 1024 / 1024);
+            }
+            row(stream, prefix, "time_ms", std::move(times));
+            row(stream, prefix, "memory_mb", std::move(memories));
+        }
+        return stream.str();
+    }
+}
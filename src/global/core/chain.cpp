@@ -0,0 +1,165 @@
+#include "core/chain.h"
+#include "core/runtime_config.h"
+#include "core/run.h"
+#include "core/memory_budget.h"
+#include "units/generator.h"
+#include "terminal.h"
+
+// chain implementation
+
+chain::chain(runtime_config &cfg, memory_budget &budget) : budget(budget) {
+    using cat = units::unit_category;
+
+    // make run sequence
+    u.emplace_back(cfg.units[cat::GENERATOR]);
+    source = std::dynamic_pointer_cast<units::generator>(u.back());
+    if (source) {
+        source->useBudget(budget);
+    }
+
+    // time limit of the solution is known after prime is run
+    if (cfg.relativeTimeLimit > 0) {
+        u.emplace_back(cfg.units[cat::PRIME]);
+    }
+
+    u.emplace_back(cfg.units[cat::TO_TEST]);
+    toTest = u.back();
+
+    if (!cfg.prime.empty() && cfg.relativeTimeLimit == 0) {
+        u.emplace_back(cfg.units[cat::PRIME]);
+    }
+
+    if (!cfg.verifier.empty() || !cfg.prime.empty()) {
+        u.emplace_back(cfg.units[cat::VERIFIER]);
+        verifier = u.back();
+    }
+
+    variants = cfg.variantUnits;
+}
+
+void chain::run(runtime_config &cfg, test_result &result) const {
+    run(cfg, result, 0, u.size());
+    if (cfg.benchRuns) {
+        bench(cfg, result);
+    }
+    if (!variants.empty()) {
+        compare(cfg, result);
+    }
+    if (source) {
+        source->learn(result);
+    }
+}
+
+void chain::bench(runtime_config &cfg, test_result &result) const {
+    if (result.verdict != verdict::ACCEPTED) {
+        return;
+    }
+
+    // the checked run is the first of warmup runs
+    if (cfg.warmupRuns == 0) {
+        result.benchTimes.push_back(result.solutionTime);
+        result.benchMemories.push_back(result.solutionMemory);
+    }
+
+    test_result run;
+    run.input = result.input;
+    run.primeTime = result.primeTime;
+
+    for (uint32_t i = 1; i < cfg.warmupRuns + cfg.benchRuns; ++i) {
+        run.output.clear();
+        run.err.clear();
+        run.execResult.error.clear();
+
+        uint64_t reserved = budget.acquire(*toTest);
+        toTest->execute(cfg, run);
+        budget.release(*toTest, reserved, run);
+
+        // solution failed this time, so the rest of runs can't be compared
+        if (terminal::interrupted() || run.verdict != verdict::ACCEPTED) {
+            break;
+        }
+        if (i >= cfg.warmupRuns) {
+            result.benchTimes.push_back(run.solutionTime);
+            result.benchMemories.push_back(run.solutionMemory);
+        }
+    }
+}
+
+void chain::compare(runtime_config &cfg, test_result &result) const {
+    if (result.verdict != verdict::ACCEPTED) {
+        return;
+    }
+    result.variants.resize(variants.size());
+
+    // variants are run right after the solution in turns,
+    // so none of them is always the first one
+    for (size_t k = 0; k < variants.size() && !terminal::interrupted(); ++k) {
+        size_t i = (result.ordinal + k) % variants.size();
+        auto &v = variants[i];
+
+        test_result run;
+        run.input = result.input;
+        run.primeTime = result.primeTime;
+        if (!cfg.prime.empty()) {
+            run.output2 = result.output2;
+        }
+
+        uint64_t reserved = budget.acquire(*v);
+        v->execute(cfg, run);
+        budget.release(*v, reserved, run);
+
+        if (run.verdict == verdict::ACCEPTED && verifier) {
+            reserved = budget.acquire(*verifier);
+            verifier->execute(cfg, run);
+            budget.release(*verifier, reserved, run);
+        }
+        result.variants[i] = {run.verdict, run.solutionTime, run.solutionMemory};
+    }
+}
+
+void chain::generate(runtime_config &cfg, test_result &result) const {
+    run(cfg, result, 0, 1);
+}
+
+void chain::check(runtime_config &cfg, test_result &result) const {
+    run(cfg, result, 1, u.size());
+}
+
+void chain::verify(runtime_config &cfg, test_result &result) const {
+    if (!verifier) {
+        return;
+    }
+    uint64_t reserved = budget.acquire(*verifier);
+    verifier->execute(cfg, result);
+    budget.release(*verifier, reserved, result);
+
+    if (terminal::interrupted()) {
+        result.verdict = verdict::NOT_TESTED;
+    }
+}
+
+void chain::run(runtime_config &cfg, test_result &result, size_t first, size_t last) const {
+    for (size_t i = first; i < last; ++i) {
+        auto &p = u[i];
+        uint64_t reserved = budget.acquire(*p);
+        p->execute(cfg, result);
+        budget.release(*p, reserved, result);
+
+        // if interrupted, there are no interesting errors
+        if (terminal::interrupted()) {
+            result.verdict = verdict::NOT_TESTED;
+            break;
+        }
+
+        // if error happened
+        if (result.verdict.isOrdinaryError() || result.verdict.isCriticalError()) {
+            break;
+        }
+
+        // no more tests or skipped
+        if (result.verdict == verdict::TESTS_OVER || result.verdict == verdict::SKIPPED
+            || result.verdict == verdict::DUPLICATE) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#include "core/checkpoint.h"
+#include "core/runtime_config.h"
+#include <fstream>
+#include <sstream>
+#include <map>
+
+namespace {
+    constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+    // settings which define what the test with some number is
+    std::map<std::string, std::string> sessionSettings(runtime_config const &cfg) {
+        return {
+                {"version", std::to_string(CHECKPOINT_VERSION)},
+                {"source",  cfg.generator.file.string()},
+                {"shard",   std::to_string(cfg.shardIndex + 1) + "/" + std::to_string(cfg.shardsCount)},
+                {"replay",  std::to_string(cfg.replay.size())}
+        };
+    }
+}
+
+// checkpoint implementation
+
+checkpoint::path checkpoint::location(runtime_config const &cfg) {
+    std::string filename = cfg.tag.empty() ? cfg.toTest.filename() : cfg.tag;
+
+    if (cfg.shardsCount > 1) {
+        filename += "_" + std::to_string(cfg.shardIndex + 1) + "-" + std::to_string(cfg.shardsCount);
+    }
+    return path("stress") / "checkpoints" / (filename + ".txt");
+}
+
+checkpoint checkpoint::load(runtime_config const &cfg) {
+    std::ifstream in(location(cfg), std::ios::binary);
+
+    if (!in.is_open()) {
+        throw std::runtime_error(
+                "[!] Nothing to resume, " + location(cfg).string() + " not found");
+    }
+
+    std::map<std::string, std::string> values;
+    std::string line;
+
+    while (std::getline(in, line)) {
+        size_t space = line.find(' ');
+        if (space != std::string::npos) {
+            values[line.substr(0, space)] = line.substr(space + 1);
+        }
+    }
+
+    for (auto const &[key, value]: sessionSettings(cfg)) {
+        if (values[key] != value) {
+            throw std::runtime_error(
+                    "[!] Checkpoint was made for another session (" + key + " differs)");
+        }
+    }
+
+    checkpoint c;
+    try {
+        c.initialSeed = std::stoul(values.at("seed"));
+        c.testsCompleted = std::stoul(values.at("completed"));
+        c.totalTime = std::stoull(values.at("total_time"));
+        c.maxTime = std::stoull(values.at("max_time"));
+        c.solutionBroken = values.at("broken") == "1";
+        c.logPath = values.at("log");
+        c.logSize = std::stoull(values.at("log_size"));
+    } catch (...) {
+        throw std::runtime_error("[!] Checkpoint " + location(cfg).string() + " is corrupted");
+    }
+    return c;
+}
+
+bool checkpoint::save(runtime_config const &cfg) const {
+    path file = location(cfg);
+    path tmp = file;
+    tmp += ".tmp";
+
+    std::error_code errCode;
+    create_directories(file.parent_path(), errCode);
+
+    std::stringstream stream;
+
+    for (auto const &[key, value]: sessionSettings(cfg)) {
+        stream << key << ' ' << value << '\n';
+    }
+    stream << "seed " << initialSeed << '\n';
+    stream << "completed " << testsCompleted << '\n';
+    stream << "total_time " << totalTime << '\n';
+    stream << "max_time " << maxTime << '\n';
+    stream << "broken " << solutionBroken << '\n';
+    stream << "log " << logPath.string() << '\n';
+    stream << "log_size " << logSize << '\n';
+
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        out << stream.str();
+        if (out.fail()) {
+            return false;
+        }
+    }
+
+    // replace the previous one at once, not to be broken by a crash
+    std::filesystem::rename(tmp, file, errCode);
+    return !errCode;
+}
+
+void checkpoint::remove(runtime_config const &cfg) {
+    std::error_code errCode;
+    std::filesystem::remove(location(cfg), errCode);
+}
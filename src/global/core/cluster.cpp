@@ -0,0 +1,283 @@
+#include "core/cluster.h"
+#include "core/runtime_config.h"
+#include "core/session.h"
+#include "core/chain.h"
+#include "core/memory_budget.h"
+#include "core/run.h"
+#include "core/serialization.h"
+#include "terminal.h"
+#include "net.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+namespace {
+    constexpr char MAGIC[] = "stress";
+    constexpr uint32_t PROTOCOL_VERSION = 3;
+    constexpr uint32_t ACCEPT_INTERVAL_MS = 100;
+    constexpr uint32_t CONNECT_INTERVAL_MS = 100;
+    constexpr uint32_t CONNECT_ATTEMPTS = 50;
+    constexpr uint32_t MAX_MESSAGE_SIZE = 1u << 30;
+
+    enum class message : uint8_t {
+        HELLO = 1, // worker -> coordinator
+        TEST,      // coordinator -> worker
+        RESULT,    // worker -> coordinator
+        BYE        // coordinator -> worker, no more tests
+    };
+
+    // coordinator may be started at the same time, so it's waited for a while
+    net::socket connect(std::string const &address) {
+        for (uint32_t attempt = 1;; ++attempt) {
+            try {
+                return net::connect(address);
+            } catch (std::runtime_error const &) {
+                if (attempt == CONNECT_ATTEMPTS || terminal::interrupted()) {
+                    throw;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(CONNECT_INTERVAL_MS));
+        }
+    }
+
+    bool sendMessage(net::socket &s, message type, std::string const &payload) {
+        packer header;
+        header.put((uint32_t) payload.size());
+        header.put((uint8_t) type);
+        return s.send(header.data.data(), header.data.size())
+               && s.send(payload.data(), payload.size());
+    }
+
+    bool receiveMessage(net::socket &s, message &type, std::string &payload) {
+        std::string header(sizeof(uint32_t) + sizeof(uint8_t), '\0');
+
+        if (!s.receive(header.data(), header.size())) {
+            return false;
+        }
+        unpacker u{header};
+        auto size = u.get<uint32_t>();
+        type = (message) u.get<uint8_t>();
+
+        if (size > MAX_MESSAGE_SIZE) {
+            return false;
+        }
+        payload.resize(size);
+        return s.receive(payload.data(), size);
+    }
+
+    // the highest values of tests run by a connection, as a min-heap,
+    // a test which gets into a leaderboard of the coordinator is surely among them
+    class leaders {
+    public:
+        bool add(size_t value) {
+            if (values.size() == session::LEADERBOARD_TESTS) {
+                if (value < values.front()) {
+                    return false;
+                }
+                std::pop_heap(values.begin(), values.end(), std::greater<>());
+                values.pop_back();
+            }
+            values.push_back(value);
+            std::push_heap(values.begin(), values.end(), std::greater<>());
+            return true;
+        }
+
+    private:
+        std::vector<size_t> values;
+    };
+
+    std::string packResult(test_result const &result, bool leading) {
+        // inputs are needed only to log failures and leaders
+        bool logged = result.verdict.isOrdinaryError() || result.verdict.isCriticalError() || leading;
+        auto const &error = result.execResult.error;
+
+        packer p;
+        p.put(result.ordinal);
+        p.put(result.id);
+        p.put(result.seed);
+        p.put((uint8_t) (verdict::value) result.verdict);
+        p.put((uint64_t) result.execResult.time);
+        p.put((uint64_t) result.execResult.memory);
+        p.put((uint64_t) result.solutionTime);
+        p.put((uint64_t) result.solutionMemory);
+        p.put((uint64_t) result.primeTime);
+        p.put((uint64_t) result.primeMemory);
+        p.put((uint64_t) result.timeLimit);
+        p.put(error.hasError() ? error.errorExplanation() : std::string());
+        p.put(logged ? result.input : std::string());
+        p.put(logged ? result.err : std::string());
+        return std::move(p.data);
+    }
+
+    bool unpackResult(std::string const &payload, test_result &result) {
+        try {
+            unpacker u{payload};
+
+            if (u.get<uint32_t>() != result.ordinal
+                || u.get<uint32_t>() != result.id
+                || u.get<uint32_t>() != result.seed) {
+                return false;
+            }
+            auto v = u.get<uint8_t>();
+            if (v > verdict::PRESENTATION_ERROR) {
+                return false;
+            }
+            result.verdict = (verdict::value) v;
+            result.execResult.time = u.get<uint64_t>();
+            result.execResult.memory = u.get<uint64_t>();
+            result.solutionTime = u.get<uint64_t>();
+            result.solutionMemory = u.get<uint64_t>();
+            result.primeTime = u.get<uint64_t>();
+            result.primeMemory = u.get<uint64_t>();
+            result.timeLimit = u.get<uint64_t>();
+
+            std::string explanation = u.getString();
+            if (!explanation.empty()) {
+                result.execResult.error.storeExplanation(std::move(explanation));
+            }
+            result.input = u.getString();
+            result.err = u.getString();
+            return true;
+
+        } catch (std::runtime_error const &) {
+            return false;
+        }
+    }
+
+    std::string hello() {
+        packer p;
+        p.put(std::string(MAGIC));
+        p.put(PROTOCOL_VERSION);
+        return std::move(p.data);
+    }
+
+    // coordinator's side of the connection
+    void handler(session &session, net::socket s) {
+        message type;
+        std::string payload;
+
+        if (!receiveMessage(s, type, payload) || type != message::HELLO || payload != hello()) {
+            terminal::syncOutput("[!] Incompatible worker rejected\n");
+            return;
+        }
+
+        test_result result;
+
+        while (session.newTest(result)) {
+            packer p;
+            p.put(result.ordinal);
+            p.put(result.id);
+            p.put(result.seed);
+
+            if (!sendMessage(s, message::TEST, p.data)
+                || !receiveMessage(s, type, payload)
+                || type != message::RESULT
+                || !unpackResult(payload, result)) {
+
+                if (!terminal::interrupted()) {
+                    terminal::syncOutput("[!] Worker disconnected, test ",
+                                         result.id + 1, " will be given to another one\n");
+                }
+                session.returnTest(result);
+                return;
+            }
+            session.processedTest(result);
+            result.clear();
+        }
+        sendMessage(s, message::BYE, "");
+    }
+
+    // worker's side of the connection
+    void remoteWorker(runtime_config &cfg, net::socket s, memory_budget &budget,
+                      std::atomic<uint32_t> &testsDone) {
+        message type;
+        std::string payload;
+        test_result result;
+        chain c(cfg, budget);
+        leaders slowest, hungriest;
+
+        if (!sendMessage(s, message::HELLO, hello())) {
+            return;
+        }
+
+        while (receiveMessage(s, type, payload)) {
+            if (type == message::BYE) {
+                return;
+            } else if (type != message::TEST || payload.size() != 3 * sizeof(uint32_t)) {
+                break;
+            }
+
+            unpacker u{payload};
+            result.ordinal = u.get<uint32_t>();
+            result.id = u.get<uint32_t>();
+            result.seed = u.get<uint32_t>();
+
+            c.run(cfg, result);
+
+            // interrupted, the test will be given to another worker
+            if (result.verdict == verdict::NOT_TESTED) {
+                return;
+            }
+            // both are added to, so don't short-circuit
+            bool leading = slowest.add(result.solutionTime) | hungriest.add(result.solutionMemory);
+            if (!sendMessage(s, message::RESULT, packResult(result, leading))) {
+                break;
+            }
+            ++testsDone;
+            result.clear();
+        }
+
+        if (!terminal::interrupted()) {
+            terminal::syncOutput("[!] Connection to the coordinator lost\n");
+        }
+    }
+}
+
+namespace cluster {
+
+    void serve(runtime_config const &cfg, session &session) {
+        net::listener listener(cfg.serveAddress);
+        std::vector<std::thread> handlers;
+
+        terminal::syncOutput("[*] Waiting for workers at ", cfg.serveAddress, "\n\n");
+
+        while (!session.finished() && !terminal::interrupted()) {
+            auto s = listener.accept(ACCEPT_INTERVAL_MS);
+            if (s.has_value()) {
+                handlers.emplace_back(handler, std::ref(session), std::move(s.value()));
+            }
+        }
+
+        for (auto &i: handlers) {
+            i.join();
+        }
+    }
+
+    void join(runtime_config &cfg, uint32_t workersCount) {
+        std::vector<net::socket> sockets;
+        std::vector<std::thread> workers;
+        std::atomic<uint32_t> testsDone = 0;
+        memory_budget budget(cfg);
+
+        // each worker has its own connection
+        for (uint32_t i = 0; i < workersCount; ++i) {
+            sockets.emplace_back(connect(cfg.joinAddress));
+        }
+
+        terminal::syncOutput("[*] Joined ", cfg.joinAddress, ", workers count: ", workersCount, '\n');
+
+        for (auto &s: sockets) {
+            workers.emplace_back(remoteWorker, std::ref(cfg), std::move(s),
+                                 std::ref(budget), std::ref(testsDone));
+        }
+
+        for (auto &i: workers) {
+            i.join();
+        }
+
+        terminal::syncOutput("[*] Tests done: ", testsDone.load(), '\n');
+        terminal::flush();
+    }
+}
@@ -0,0 +1,181 @@
+#include "core/complexity.h"
+#include "core/runtime_config.h"
+#include "core/run.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace {
+    // width of the longest bar of a curve
+    constexpr size_t CURVE_WIDTH = 30;
+
+    // values which differ less are considered to be constant
+    constexpr double CONSTANT_SPREAD = 0.1;
+
+    // simpler growth is preferred if it fits almost as well,
+    // relative to root mean square of values
+    constexpr double FIT_TOLERANCE = 0.05;
+
+    struct growth {
+        char const *name;
+        std::function<double(double)> f;
+    };
+
+    const growth GROWTHS[] = {
+            {"O(1)",          [](double) { return 1.0; }},
+            {"O(log n)",      [](double n) { return std::log2(n); }},
+            {"O(n)",          [](double n) { return n; }},
+            {"O(n log n)",    [](double n) { return n * std::log2(n); }},
+            {"O(n^2)",        [](double n) { return n * n; }},
+            {"O(n^2 log n)",  [](double n) { return n * n * std::log2(n); }},
+            {"O(n^3)",        [](double n) { return n * n * n; }},
+            {"O(2^n)",        [](double n) { return std::exp2(n); }},
+    };
+
+    // squared error of the best y = a + c * f(x), a and c are not negative
+    double fitError(growth const &g, std::vector<std::pair<double, double>> const &points) {
+        double n = (double) points.size();
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (auto [size, y]: points) {
+            double x = g.f(size);
+            if (!std::isfinite(x)) {
+                return INFINITY;
+            }
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+
+        double var = sxx - sx * sx / n;
+        double c = var > 0 ? (sxy - sx * sy / n) / var : 0;
+        double a = (sy - c * sx) / n;
+        if (c < 0) {
+            c = 0;
+            a = sy / n;
+        } else if (a < 0) {
+            a = 0;
+            c = sxx > 0 ? sxy / sxx : 0;
+        }
+
+        double error = 0;
+        for (auto [size, y]: points) {
+            double d = y - (a + c * g.f(size));
+            error += d * d;
+        }
+        return error;
+    }
+
+    std::string fit(std::vector<std::pair<double, double>> const &points) {
+        auto [lo, hi] = std::minmax_element(points.begin(), points.end(), [](auto const &a, auto const &b) {
+            return a.second < b.second;
+        });
+        if (hi->second - lo->second <= CONSTANT_SPREAD * hi->second) {
+            return GROWTHS[0].name;
+        }
+
+        std::vector<double> errors;
+        for (auto const &g: GROWTHS) {
+            errors.push_back(fitError(g, points));
+        }
+        double best = *std::min_element(errors.begin(), errors.end());
+
+        double total = 0;
+        for (auto [size, y]: points) {
+            total += y * y;
+        }
+        for (size_t i = 0; i < errors.size(); ++i) {
+            if (errors[i] <= best + FIT_TOLERANCE * FIT_TOLERANCE * total) {
+                return GROWTHS[i].name;
+            }
+        }
+        return GROWTHS[0].name;
+    }
+
+    size_t median(std::vector<size_t> values) {
+        std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+        return values[values.size() / 2];
+    }
+
+    void table(std::stringstream &stream, std::string const &title,
+               std::map<uint64_t, std::pair<std::vector<size_t>, std::vector<size_t>>> const &bySize) {
+        std::vector<std::pair<double, double>> times;
+        std::vector<std::pair<double, double>> memories;
+        for (auto const &[size, values]: bySize) {
+            times.emplace_back((double) size, (double) median(values.first));
+            memories.emplace_back((double) size, (double) median(values.second));
+        }
+        double maxTime = std::max(1.0, std::max_element(times.begin(), times.end(), [](auto a, auto b) {
+            return a.second < b.second;
+        })->second);
+
+        stream << '\n' << "[*] Complexity of " << title << ":\n";
+        stream << std::setw(12) << "size" << std::setw(10) << "time" << std::setw(10) << "memory" << '\n';
+        for (size_t i = 0; i < times.size(); ++i) {
+            stream << std::setw(12) << (uint64_t) times[i].first
+                   << std::setw(7) << (uint64_t) times[i].second << " ms"
+                   << std::setw(7) << std::fixed << std::setprecision(1)
+                   << memories[i].second / 1024 / 1024 << " MB  "
+                   << std::string((size_t) std::lround(times[i].second / maxTime * CURVE_WIDTH), '#') << '\n';
+        }
+
+        if (times.size() < 3) {
+            stream << "Not enough sizes to estimate\n";
+            return;
+        }
+        stream << "Time: " << fit(times) << ", memory: " << fit(memories) << '\n';
+    }
+}
+
+namespace complexity {
+
+    std::vector<uint64_t> sizes(uint64_t lo, uint64_t hi) {
+        std::vector<uint64_t> result;
+        for (uint64_t size = lo; size <= hi; size *= 2) {
+            result.push_back(size);
+            if (size > hi / 2) {
+                break;
+            }
+        }
+        return result;
+    }
+
+    uint64_t testSize(runtime_config const &cfg, uint32_t testId) {
+        size_t index = std::min<size_t>(testId / cfg.sizeRepeats, cfg.sizes.size() - 1);
+        return cfg.sizes[index];
+    }
+
+    measurement measure(runtime_config const &cfg, test_result const &result) {
+        measurement m;
+        m.size = testSize(cfg, result.id);
+        m.time = result.solutionTime;
+        m.memory = result.solutionMemory;
+        m.primeTime = result.primeTime;
+        m.primeMemory = result.primeMemory;
+        return m;
+    }
+
+    std::string report(runtime_config const &cfg, std::vector<measurement> const &measurements) {
+        std::map<uint64_t, std::pair<std::vector<size_t>, std::vector<size_t>>> solution, prime;
+        for (auto const &m: measurements) {
+            solution[m.size].first.push_back(m.time);
+            solution[m.size].second.push_back(m.memory);
+            if (!cfg.prime.empty()) {
+                prime[m.size].first.push_back(m.primeTime);
+                prime[m.size].second.push_back(m.primeMemory);
+            }
+        }
+
+        std::stringstream stream;
+        if (!solution.empty()) {
+            table(stream, "solution to test", solution);
+        }
+        if (!prime.empty()) {
+            table(stream, "prime solution", prime);
+        }
+        return stream.str();
+    }
+}
@@ -0,0 +1,153 @@
+#include "core/compression.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(STRESS_WITH_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(STRESS_WITH_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace {
+    constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    constexpr std::string_view GZIP_MAGIC = "\x1f\x8b";
+    constexpr std::string_view ZSTD_MAGIC = "\x28\xb5\x2f\xfd";
+
+#if defined(STRESS_WITH_ZLIB)
+    bool gunzip(std::string_view data, std::string &out, std::string &error) {
+        z_stream zs{};
+
+        // gzip header is detected automatically
+        if (inflateInit2(&zs, 15 + 32) != Z_OK) {
+            error = "unable to init zlib";
+            return false;
+        }
+        zs.next_in = (Bytef *) data.data();
+
+        // input of 4 GiB and more is given by slices, as its size doesn't fit in uInt
+        size_t remaining = data.size();
+        auto feed = [&] {
+            zs.avail_in = (uInt) std::min<size_t>(remaining, std::numeric_limits<uInt>::max());
+            remaining -= zs.avail_in;
+        };
+        feed();
+
+        int ret = Z_OK;
+        while (ret != Z_STREAM_END || zs.avail_in > 0 || remaining > 0) {
+            // concatenated gzip members make a single file
+            if (ret == Z_STREAM_END) {
+                inflateReset(&zs);
+            }
+            if (zs.avail_in == 0) {
+                feed();
+            }
+
+            size_t prefix = out.size();
+            out.resize(prefix + CHUNK_SIZE);
+            zs.next_out = (Bytef *) out.data() + prefix;
+            zs.avail_out = (uInt) CHUNK_SIZE;
+
+            ret = inflate(&zs, Z_NO_FLUSH);
+            out.resize(prefix + CHUNK_SIZE - zs.avail_out);
+
+            if (ret != Z_OK && ret != Z_STREAM_END) {
+                error = zs.msg ? zs.msg : "broken gzip data";
+                inflateEnd(&zs);
+                return false;
+            } else if (ret == Z_OK && zs.avail_in == 0 && remaining == 0 && zs.avail_out != 0) {
+                error = "truncated gzip data";
+                inflateEnd(&zs);
+                return false;
+            }
+        }
+        inflateEnd(&zs);
+        return true;
+    }
+#endif
+
+#if defined(STRESS_WITH_ZSTD)
+    bool unzstd(std::string_view data, std::string &out, std::string &error) {
+        ZSTD_DStream *ds = ZSTD_createDStream();
+        if (ds == nullptr) {
+            error = "unable to init zstd";
+            return false;
+        }
+
+        ZSTD_inBuffer in{data.data(), data.size(), 0};
+        size_t ret = 0;
+
+        while (in.pos < in.size) {
+            size_t prefix = out.size();
+            out.resize(prefix + CHUNK_SIZE);
+            ZSTD_outBuffer o{out.data() + prefix, CHUNK_SIZE, 0};
+
+            ret = ZSTD_decompressStream(ds, &o, &in);
+            out.resize(prefix + o.pos);
+
+            if (ZSTD_isError(ret)) {
+                error = ZSTD_getErrorName(ret);
+                ZSTD_freeDStream(ds);
+                return false;
+            }
+        }
+
+        // frame is not finished
+        while (ret != 0) {
+            size_t prefix = out.size();
+            out.resize(prefix + CHUNK_SIZE);
+            ZSTD_outBuffer o{out.data() + prefix, CHUNK_SIZE, 0};
+
+            ret = ZSTD_decompressStream(ds, &o, &in);
+            out.resize(prefix + o.pos);
+
+            if (ZSTD_isError(ret) || o.pos == 0) {
+                error = ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "truncated zstd data";
+                ZSTD_freeDStream(ds);
+                return false;
+            }
+        }
+        ZSTD_freeDStream(ds);
+        return true;
+    }
+#endif
+}
+
+namespace compression {
+
+    format detect(std::string_view data) {
+        if (data.substr(0, GZIP_MAGIC.size()) == GZIP_MAGIC) {
+            return format::GZIP;
+        } else if (data.substr(0, ZSTD_MAGIC.size()) == ZSTD_MAGIC) {
+            return format::ZSTD;
+        }
+        return format::NONE;
+    }
+
+    bool decompress(std::string_view data, std::string &out, std::string &error) {
+        switch (detect(data)) {
+            case format::NONE:
+                out.append(data);
+                return true;
+
+            case format::GZIP:
+#if defined(STRESS_WITH_ZLIB)
+                return gunzip(data, out, error);
+#else
+                error = "gzip is not supported by this build";
+                return false;
+#endif
+
+            case format::ZSTD:
+#if defined(STRESS_WITH_ZSTD)
+                return unzstd(data, out, error);
+#else
+                error = "zstd is not supported by this build";
+                return false;
+#endif
+        }
+        return false;
+    }
+}
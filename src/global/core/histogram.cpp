@@ -0,0 +1,116 @@
+#include "core/histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    // buckets in each power of two, so values are kept with relative error below 1/32
+    constexpr uint32_t SUB_BITS = 5;
+    constexpr uint64_t SUB_BUCKETS = 1 << SUB_BITS;
+
+    // width of the longest bar of a chart
+    constexpr size_t CHART_WIDTH = 30;
+
+    constexpr double PERCENTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+    size_t bucket(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return value;
+        }
+        uint32_t shift = std::bit_width(value) - 1 - SUB_BITS;
+        return SUB_BUCKETS + shift * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+    }
+
+    uint64_t lowest(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        uint64_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        return (SUB_BUCKETS + (index - SUB_BUCKETS) % SUB_BUCKETS) << shift;
+    }
+
+    std::string format(uint64_t value, bool memory) {
+        std::stringstream stream;
+        if (!memory) {
+            stream << value << " ms";
+        } else if (value < 1024 * 1024) {
+            stream << value / 1024 << " KB";
+        } else {
+            stream << std::fixed << std::setprecision(1) << (double) value / 1024 / 1024 << " MB";
+        }
+        return stream.str();
+    }
+
+    std::string label(double share) {
+        std::stringstream stream;
+        stream << 'p' << share * 100;
+        return stream.str();
+    }
+}
+
+namespace histogram {
+
+    void distribution::add(uint64_t value) {
+        size_t index = bucket(value);
+        if (index >= buckets.size()) {
+            buckets.resize(index + 1);
+        }
+        ++buckets[index];
+        ++total;
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    uint64_t distribution::percentile(double share) const {
+        auto rank = std::max<uint64_t>(1, (uint64_t) std::ceil(share * (double) total));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return std::clamp(lowest(i + 1) - 1, minimum, maximum);
+            }
+        }
+        return maximum;
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> distribution::octaves() const {
+        std::vector<std::pair<uint64_t, uint64_t>> result;
+        if (!total) {
+            return result;
+        }
+
+        size_t first = std::bit_width(minimum);
+        for (size_t i = first; i <= (size_t) std::bit_width(maximum); ++i) {
+            result.emplace_back(i ? uint64_t(1) << (i - 1) : 0, 0);
+        }
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            if (buckets[i]) {
+                result[std::bit_width(lowest(i)) - first].second += buckets[i];
+            }
+        }
+        return result;
+    }
+
+    std::string report(std::string const &title, distribution const &d, bool memory) {
+        std::stringstream stream;
+        stream << '\n' << "[*] " << title << ":\n";
+        for (double share: PERCENTILES) {
+            stream << label(share) << ' ' << format(d.percentile(share), memory) << ", ";
+        }
+        stream << "max " << format(d.max(), memory) << '\n';
+
+        auto rows = d.octaves();
+        uint64_t highest = 0;
+        for (auto [from, count]: rows) {
+            highest = std::max(highest, count);
+        }
+        for (auto [from, count]: rows) {
+            size_t width = count ? std::max<size_t>(1, std::lround((double) count / (double) highest * CHART_WIDTH)) : 0;
+            stream << std::setw(12) << format(from, memory) << std::setw(10) << count << "  "
+                   << std::string(width, '#') << '\n';
+        }
+        return stream.str();
+    }
+}
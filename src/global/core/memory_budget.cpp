@@ -0,0 +1,64 @@
+#include "core/memory_budget.h"
+#include "core/runtime_config.h"
+#include "core/run.h"
+#include "terminal.h"
+
+namespace {
+    // waiting is interrupted by ctrl+c, which doesn't notify anyone
+    constexpr std::chrono::milliseconds INTERRUPTION_CHECK_INTERVAL{100};
+}
+
+// memory_budget implementation
+
+memory_budget::memory_budget(runtime_config const &cfg) : cfg(cfg), budget(cfg.memoryBudget) {}
+
+uint64_t memory_budget::acquire(units::unit const &unit) {
+    if (budget == 0 || !accountable(unit)) {
+        return 0;
+    }
+    std::unique_lock lck(mutex);
+    uint64_t need = estimate(unit);
+
+    // the one which doesn't fit at all is run alone
+    while (used != 0 && used + need > budget && !terminal::interrupted()) {
+        cond.wait_for(lck, INTERRUPTION_CHECK_INTERVAL);
+        need = estimate(unit);
+    }
+    used += need;
+    return need;
+}
+
+void memory_budget::release(units::unit const &unit, uint64_t reserved, test_result const &result) {
+    if (budget == 0 || !accountable(unit)) {
+        return;
+    }
+    std::lock_guard lck(mutex);
+    used -= reserved;
+
+    // memory is SIZE_MAX if it is unknown
+    if (result.execResult.memory != SIZE_MAX) {
+        uint64_t &peak = peaks[(size_t) unit.cat];
+        peak = std::max(peak, (uint64_t) result.execResult.memory);
+    }
+
+    buffers = std::max(buffers, (uint64_t) (result.input.size() + result.output.size()
+                                            + result.output2.size() + result.err.size()));
+    cond.notify_all();
+}
+
+uint64_t memory_budget::testEstimate(runtime_config const &cfg) {
+    // units of a test are run one by one, so the heaviest known one matters
+    return std::max(cfg.toTest.memoryLimit, cfg.prime.memoryLimit);
+}
+
+bool memory_budget::accountable(units::unit const &unit) const {
+    if (unit.cat == units::unit_category::GENERATOR) {
+        return cfg.testsSource == tests_source::EXECUTABLE;
+    }
+    return !unit.empty();
+}
+
+uint64_t memory_budget::estimate(units::unit const &unit) const {
+    uint64_t peak = unit.memoryLimit ? unit.memoryLimit : peaks[(size_t) unit.cat];
+    return peak + buffers;
+}
@@ -0,0 +1,197 @@
+#include "core/multitest.h"
+#include "core/runtime_config.h"
+#include "core/session.h"
+#include "core/chain.h"
+#include "core/run.h"
+#include "terminal.h"
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace {
+    // test is made and can be run
+    bool generated(test_result const &test) {
+        return !test.verdict.isCriticalError() && !test.verdict.isOrdinaryError()
+               && test.verdict != verdict::TESTS_OVER && test.verdict != verdict::SKIPPED
+               && test.verdict != verdict::DUPLICATE;
+    }
+
+    test_result pack(runtime_config const &cfg, std::vector<test_result *> const &tests) {
+        test_result packed;
+        packed.verdict = verdict::ACCEPTED;
+        if (cfg.multitestCount) {
+            packed.input = std::to_string(tests.size()) + '\n';
+        }
+
+        for (auto *test: tests) {
+            packed.input += test->input;
+            // tests are not always ended by a line break
+            if (!test->input.empty() && test->input.back() != '\n') {
+                packed.input += '\n';
+            }
+        }
+        return packed;
+    }
+
+    // outputs of the tests, which are separated by the given line
+    bool split(std::string const &output, std::string_view separator, size_t count,
+               std::vector<std::string> &outputs) {
+        outputs.assign(1, std::string());
+
+        for (size_t pos = 0; pos < output.size();) {
+            size_t end = std::min(output.find('\n', pos), output.size() - 1) + 1;
+            std::string_view line(output.data() + pos, end - pos);
+            pos = end;
+
+            std::string_view content = line;
+            while (!content.empty() && (content.back() == '\n' || content.back() == '\r')) {
+                content.remove_suffix(1);
+            }
+            if (content == separator) {
+                outputs.emplace_back();
+            } else {
+                outputs.back() += line;
+            }
+        }
+
+        // the last output may be followed by the separator too
+        if (outputs.size() == count + 1 && outputs.back().find_first_not_of(" \t\r\n") == std::string::npos) {
+            outputs.pop_back();
+        }
+        return outputs.size() == count;
+    }
+
+    // find the failed tests by outputs of each of them, without running the group again
+    bool verifyApart(runtime_config &cfg, chain const &c, test_result const &packed,
+                     std::vector<test_result *> const &tests) {
+        if (!cfg.multitestSeparator
+            || (packed.verdict != verdict::WRONG_ANSWER && packed.verdict != verdict::PRESENTATION_ERROR)) {
+            return false;
+        }
+
+        // output of prime is replaced by the one of custom verifier
+        bool primeOutputs = cfg.verifier.empty();
+        std::vector<std::string> outputs, outputs2;
+
+        if (!split(packed.output, *cfg.multitestSeparator, tests.size(), outputs)
+            || (primeOutputs && !split(packed.output2, *cfg.multitestSeparator, tests.size(), outputs2))) {
+            return false;
+        }
+
+        std::vector<test_result> results(tests.size());
+        bool failed = false;
+
+        for (size_t i = 0; i < tests.size(); ++i) {
+            auto &r = results[i];
+            r = pack(cfg, {tests[i]});
+            r.ordinal = tests[i]->ordinal;
+            r.id = tests[i]->id;
+            r.seed = tests[i]->seed;
+            r.output = std::move(outputs[i]);
+            if (primeOutputs) {
+                r.output2 = std::move(outputs2[i]);
+            }
+            c.verify(cfg, r);
+            failed |= r.verdict != verdict::ACCEPTED;
+        }
+
+        // the group failed as a whole, so its parts are checked by running them
+        if (!failed) {
+            return false;
+        }
+
+        for (size_t i = 0; i < tests.size(); ++i) {
+            auto &r = results[i];
+            r.execResult.time = packed.execResult.time / tests.size();
+            r.execResult.memory = packed.execResult.memory;
+
+            if (r.verdict == verdict::ACCEPTED) {
+                tests[i]->verdict = verdict::ACCEPTED;
+                tests[i]->execResult.time = r.execResult.time;
+                tests[i]->execResult.memory = r.execResult.memory;
+            } else {
+                // input is of a group of one test, so the failure can be reproduced
+                *tests[i] = std::move(r);
+            }
+        }
+        return true;
+    }
+
+    // run the tests at once, if they fail, find the failed ones
+    // by their outputs or by bisection
+    void check(runtime_config &cfg, chain const &c, std::vector<test_result *> const &tests) {
+        test_result packed = pack(cfg, tests);
+        c.check(cfg, packed);
+
+        if (packed.verdict == verdict::ACCEPTED) {
+            for (auto *test: tests) {
+                test->verdict = verdict::ACCEPTED;
+                test->execResult.time = packed.execResult.time / tests.size();
+                test->execResult.memory = packed.execResult.memory;
+            }
+            return;
+        }
+
+        if (packed.verdict == verdict::NOT_TESTED) {
+            for (auto *test: tests) {
+                test->verdict = verdict::NOT_TESTED;
+            }
+            return;
+        }
+
+        if (tests.size() > 1 && verifyApart(cfg, c, packed, tests)) {
+            return;
+        }
+
+        if (tests.size() == 1) {
+            // log the input which is run, so the failure can be reproduced
+            packed.ordinal = tests[0]->ordinal;
+            packed.id = tests[0]->id;
+            packed.seed = tests[0]->seed;
+            *tests[0] = std::move(packed);
+            return;
+        }
+
+        size_t half = tests.size() / 2;
+        check(cfg, c, {tests.begin(), tests.begin() + (std::ptrdiff_t) half});
+        check(cfg, c, {tests.begin() + (std::ptrdiff_t) half, tests.end()});
+    }
+}
+
+namespace multitest {
+
+    void worker(runtime_config &cfg, session &session, memory_budget &budget) {
+        chain c(cfg, budget);
+        std::vector<test_result> tests(cfg.multitestSize);
+
+        while (true) {
+            size_t count = 0;
+            std::vector<test_result *> group;
+
+            // taken tests are in flight, so only the first one may wait
+            for (; count < tests.size() && session.newTest(tests[count], count == 0); ++count) {
+                c.generate(cfg, tests[count]);
+                if (generated(tests[count])) {
+                    group.push_back(&tests[count]);
+                }
+            }
+
+            if (!group.empty() && !terminal::interrupted()) {
+                check(cfg, c, group);
+            }
+
+            // each test index must be reported, even if there are no more tests
+            for (size_t i = 0; i < count; ++i) {
+                if (terminal::interrupted()) {
+                    tests[i].verdict = verdict::NOT_TESTED;
+                }
+                session.processedTest(tests[i]);
+                tests[i].clear();
+            }
+
+            if (count == 0) {
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,277 @@
+#include "core/mutator.h"
+#include "core/run.h"
+#include <algorithm>
+#include <charconv>
+#include <limits>
+
+namespace {
+    // changes made to a single test at most
+    constexpr uint32_t MAX_CHANGES = 4;
+
+    // tests learned at most, so memory of a long session is bounded
+    constexpr size_t MAX_CORPUS_TESTS = 4096;
+    constexpr size_t MAX_CORPUS_BYTES = 64 * 1024 * 1024;
+
+    // hardest tests kept in search of the worst case
+    constexpr size_t MAX_POPULATION = 64;
+
+    // known tests compared to pick the one to change
+    constexpr uint32_t TOURNAMENT_SIZE = 3;
+
+    // splitmix64
+    class rng {
+    public:
+        explicit rng(uint64_t seed) : state(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        // uniform enough in [0, n), n > 0
+        size_t below(size_t n) {
+            return (size_t) (next() % n);
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    // [begin, end) of a whitespace-separated token
+    using span = std::pair<size_t, size_t>;
+
+    std::vector<span> tokens(std::string const &test) {
+        std::vector<span> result;
+        size_t pos = 0;
+        while ((pos = test.find_first_not_of(" \t\r\n", pos)) != std::string::npos) {
+            size_t end = std::min(test.find_first_of(" \t\r\n", pos), test.size());
+            result.emplace_back(pos, end);
+            pos = end;
+        }
+        return result;
+    }
+
+    // [begin, end) of lines, with their line breaks
+    std::vector<span> lines(std::string const &test) {
+        std::vector<span> result;
+        for (size_t begin = 0; begin < test.size();) {
+            size_t end = test.find('\n', begin);
+            end = end == std::string::npos ? test.size() : end + 1;
+            result.emplace_back(begin, end);
+            begin = end;
+        }
+        return result;
+    }
+
+    bool parseNumber(std::string const &test, span s, int64_t &value) {
+        auto [ptr, ec] = std::from_chars(test.data() + s.first, test.data() + s.second, value);
+        return ec == std::errc() && ptr == test.data() + s.second;
+    }
+
+    // values near the given one and at the edges of common types,
+    // overflows wrap around on purpose
+    int64_t perturb(rng &r, int64_t v) {
+        using i32 = std::numeric_limits<int32_t>;
+        using i64 = std::numeric_limits<int64_t>;
+        auto add = [](int64_t a, int64_t b) { return (int64_t) ((uint64_t) a + (uint64_t) b); };
+
+        switch (r.below(9)) {
+            case 0:
+                return add(v, 1);
+            case 1:
+                return add(v, -1);
+            case 2:
+                return add(v, (int64_t) r.below(33) - 16);
+            case 3:
+                return (int64_t) (0 - (uint64_t) v);
+            case 4:
+                return (int64_t) ((uint64_t) v * 2);
+            case 5:
+                return v / 2;
+            case 6:
+                return (int64_t) r.below(3) - 1;
+            case 7: {
+                const int64_t edges[] = {i32::max(), i32::min(), (int64_t) i32::max() + 1, 1000000000,
+                                         1000000007, 998244353};
+                return edges[r.below(std::size(edges))];
+            }
+            default: {
+                const int64_t edges[] = {i64::max(), i64::min(), 1000000000000000000ll, 1ll << 32};
+                return edges[r.below(std::size(edges))];
+            }
+        }
+    }
+
+    void replace(std::string &test, span s, std::string const &with) {
+        test.replace(s.first, s.second - s.first, with);
+    }
+
+    // a single random change of the test
+    void change(rng &r, std::string &test, std::string const &donor) {
+        auto t = tokens(test);
+        if (t.empty()) {
+            test = donor;
+            return;
+        }
+
+        switch (r.below(5)) {
+            case 0:
+            case 1: {
+                // numbers are most likely to matter, a few tokens are tried to find one
+                for (uint32_t tries = 0; tries < 8; ++tries) {
+                    span s = t[r.below(t.size())];
+                    int64_t value;
+                    if (parseNumber(test, s, value)) {
+                        replace(test, s, std::to_string(perturb(r, value)));
+                        return;
+                    }
+                }
+                [[fallthrough]];
+            }
+            case 2: {
+                // token of another test, or of the same one
+                auto d = tokens(donor);
+                span s = t[r.below(t.size())];
+                if (d.empty()) {
+                    span other = t[r.below(t.size())];
+                    replace(test, s, test.substr(other.first, other.second - other.first));
+                } else {
+                    span other = d[r.below(d.size())];
+                    replace(test, s, donor.substr(other.first, other.second - other.first));
+                }
+                return;
+            }
+            case 3: {
+                // line gets longer or shorter by a token
+                span s = t[r.below(t.size())];
+                if (r.below(2)) {
+                    test.insert(s.second, " " + test.substr(s.first, s.second - s.first));
+                } else {
+                    size_t end = s.second < test.size() && test[s.second] == ' ' ? s.second + 1 : s.second;
+                    test.erase(s.first, end - s.first);
+                }
+                return;
+            }
+            default: {
+                // test gets longer or shorter by a line
+                auto l = lines(test);
+                span s = l[r.below(l.size())];
+                switch (r.below(3)) {
+                    case 0:
+                        test.insert(s.first, test.substr(s.first, s.second - s.first));
+                        break;
+                    case 1:
+                        test.erase(s.first, s.second - s.first);
+                        break;
+                    default:
+                        test.resize(s.second);
+                        break;
+                }
+                return;
+            }
+        }
+    }
+}
+
+// mutator implementation
+
+void mutator::add(std::string test) {
+    std::lock_guard lck(mutex);
+    corpusBytes += test.size();
+    corpus.push_back(std::move(test));
+    fitness.push_back(0);
+}
+
+bool mutator::empty() const {
+    std::lock_guard lck(mutex);
+    return corpus.empty();
+}
+
+std::string mutator::mutate(uint32_t seed, uint32_t attempt) const {
+    rng r((uint64_t) seed << 32 | attempt);
+    std::string test;
+    std::string donor;
+    {
+        std::lock_guard lck(mutex);
+
+        // harder test is more likely to be picked, all of them are equal otherwise
+        size_t parent = r.below(corpus.size());
+        for (uint32_t i = 1; i < TOURNAMENT_SIZE; ++i) {
+            size_t other = r.below(corpus.size());
+            if (fitness[other] > fitness[parent]) {
+                parent = other;
+            }
+        }
+        test = corpus[parent];
+        donor = corpus[r.below(corpus.size())];
+    }
+
+    for (size_t changes = 1 + r.below(MAX_CHANGES); changes > 0; --changes) {
+        change(r, test, donor);
+    }
+    return test;
+}
+
+std::string mutator::original(uint32_t seed) const {
+    std::lock_guard lck(mutex);
+    return corpus[seed % corpus.size()];
+}
+
+bool mutator::learn(test_result const &result) {
+    if (!(result.verdict == verdict::ACCEPTED || result.verdict.isOrdinaryError())) {
+        return false;
+    }
+
+    if (worst != worst_case::NONE) {
+        return select(result);
+    }
+
+    // behaviour of the solution is told apart up to powers of two,
+    // execution result is of the last unit of the chain
+    auto log2 = [](uint64_t x) {
+        uint64_t bits = 0;
+        for (; x; x >>= 1) {
+            ++bits;
+        }
+        return bits;
+    };
+    uint64_t behaviour = (uint64_t) verdict::value(result.verdict) << 24
+                         | log2(result.solutionTime) << 16
+                         | log2(result.solutionMemory >> 20) << 8
+                         | log2(result.output.size());
+
+    std::lock_guard lck(mutex);
+    if (corpus.size() >= MAX_CORPUS_TESTS || corpusBytes + result.input.size() > MAX_CORPUS_BYTES
+        || !behaviours.insert(behaviour).second) {
+        return false;
+    }
+    corpusBytes += result.input.size();
+    corpus.push_back(result.input);
+    fitness.push_back(0);
+    return true;
+}
+
+bool mutator::select(test_result const &result) {
+    size_t f = worst == worst_case::TIME ? result.solutionTime : result.solutionMemory;
+    std::lock_guard lck(mutex);
+
+    if (corpus.size() < MAX_POPULATION && corpusBytes + result.input.size() <= MAX_CORPUS_BYTES) {
+        corpusBytes += result.input.size();
+        corpus.push_back(result.input);
+        fitness.push_back(f);
+        return true;
+    }
+
+    // the easiest test is replaced
+    auto weakest = std::min_element(fitness.begin(), fitness.end());
+    size_t i = weakest - fitness.begin();
+    if (f <= *weakest || corpusBytes - corpus[i].size() + result.input.size() > MAX_CORPUS_BYTES) {
+        return false;
+    }
+    corpusBytes = corpusBytes - corpus[i].size() + result.input.size();
+    corpus[i] = result.input;
+    *weakest = f;
+    return true;
+}
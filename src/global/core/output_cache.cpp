@@ -0,0 +1,67 @@
+#include "core/output_cache.h"
+#include "core/pack.h"
+#include "core/run.h"
+#include "invoker.h"
+#include <fstream>
+#include <thread>
+
+// output_cache implementation
+
+output_cache::output_cache(path const &program) {
+    uint64_t programHash = pack::fileHash(program);
+    if (programHash == 0) {
+        throw std::runtime_error("[!] Unable to read " + program.string());
+    }
+    dir = path("stress") / "cache" / "outputs" / pack::hex(programHash);
+
+    std::error_code errCode;
+    create_directories(dir, errCode);
+
+    if (!is_directory(dir)) {
+        throw std::runtime_error("[!] Path ./" + dir.string() + " couldn't be created");
+    }
+}
+
+bool output_cache::load(std::string const &input, std::string &output, execution_result &result) const {
+    std::ifstream in(entry(input), std::ios::binary);
+
+    // the first line holds time and memory of the run
+    if (!in.is_open() || !(in >> result.time >> result.memory) || in.get() != '\n') {
+        return false;
+    }
+    output.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+}
+
+bool output_cache::store(std::string const &input, std::string const &output,
+                         execution_result const &result) const {
+    path file = entry(input);
+
+    // other workers may read the entry, so it appears at once,
+    // and other sessions may share the cache, so their names differ too
+    path tmp = file;
+    tmp += "." + std::to_string(invoker::processId())
+           + "_" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out << result.time << ' ' << result.memory << '\n' << output;
+
+        if (out.fail()) {
+            return false;
+        }
+    }
+
+    std::error_code errCode;
+    rename(tmp, file, errCode);
+    if (errCode) {
+        remove(tmp, errCode);
+        return false;
+    }
+    return true;
+}
+
+output_cache::path output_cache::entry(std::string const &input) const {
+    // size makes collisions of the hash even less likely
+    return dir / (pack::hex(pack::hash(input)) + "_" + std::to_string(input.size()) + ".txt");
+}
@@ -0,0 +1,157 @@
+#include "core/pack.h"
+#include "core/serialization.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+    constexpr char MAGIC[] = "STRESSPK";
+    constexpr size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+    constexpr uint32_t PACK_VERSION = 1;
+
+    // magic, version, reserved, generator hash
+    constexpr size_t HEADER_SIZE = MAGIC_SIZE + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+    // id, seed, offset, size
+    constexpr size_t ENTRY_SIZE = 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+    // index offset, count of tests, magic
+    constexpr size_t FOOTER_SIZE = 2 * sizeof(uint64_t) + MAGIC_SIZE;
+
+    constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+}
+
+namespace pack {
+
+    uint64_t hash(std::string_view data, uint64_t seed) {
+        for (char c: data) {
+            seed = (seed ^ (unsigned char) c) * FNV_PRIME;
+        }
+        return seed;
+    }
+
+    uint64_t fileHash(path const &file) {
+        std::ifstream in(file, std::ios::binary);
+        if (!in.is_open()) {
+            return 0;
+        }
+
+        uint64_t result = hash({});
+        char buf[1 << 16];
+
+        while (in.read(buf, sizeof(buf)) || in.gcount() > 0) {
+            result = hash({buf, (size_t) in.gcount()}, result);
+        }
+        return result;
+    }
+
+    std::string hex(uint64_t value) {
+        std::stringstream s;
+        s << std::hex << std::setw(16) << std::setfill('0') << value;
+        return s.str();
+    }
+
+    // writer implementation
+
+    writer::writer(path const &file, uint64_t generatorHash) {
+        out.open(file, std::ios::binary | std::ios::trunc);
+
+        packer header;
+        header.data.append(MAGIC, MAGIC_SIZE);
+        header.put(PACK_VERSION);
+        header.put((uint32_t) 0);
+        header.put(generatorHash);
+        out << header.data;
+
+        if (out.fail()) {
+            throw std::runtime_error("[!] Unable to create " + file.string());
+        }
+        offset = HEADER_SIZE;
+    }
+
+    bool writer::write(uint32_t id, uint32_t seed, std::string const &input) {
+        out << input;
+        index.push_back({id, seed, offset, input.size()});
+        offset += input.size();
+        return !out.fail();
+    }
+
+    writer::~writer() {
+        // tests are recorded in order of starting, which is not always the order of ids
+        std::sort(index.begin(), index.end(), [](auto const &a, auto const &b) {
+            return a.id < b.id;
+        });
+
+        packer tail;
+        for (auto const &e: index) {
+            tail.put(e.id);
+            tail.put(e.seed);
+            tail.put(e.offset);
+            tail.put(e.size);
+        }
+        tail.put(offset);
+        tail.put((uint64_t) index.size());
+        tail.data.append(MAGIC, MAGIC_SIZE);
+        out << tail.data;
+    }
+
+    // reader implementation
+
+    bool reader::open(path const &file) {
+        if (!mapping.open(file)) {
+            return false;
+        }
+        std::string_view data = mapping.view();
+
+        if (data.size() < HEADER_SIZE + FOOTER_SIZE
+            || data.substr(0, MAGIC_SIZE) != std::string_view(MAGIC, MAGIC_SIZE)
+            || data.substr(data.size() - MAGIC_SIZE) != std::string_view(MAGIC, MAGIC_SIZE)) {
+            return false;
+        }
+
+        try {
+            unpacker header{data.substr(MAGIC_SIZE)};
+            if (header.get<uint32_t>() != PACK_VERSION) {
+                return false;
+            }
+            header.get<uint32_t>();
+            generatorHash = header.get<uint64_t>();
+
+            unpacker footer{data.substr(data.size() - FOOTER_SIZE)};
+            auto indexOffset = footer.get<uint64_t>();
+            auto count = footer.get<uint64_t>();
+
+            if (indexOffset > data.size() - FOOTER_SIZE
+                || count != (data.size() - FOOTER_SIZE - indexOffset) / ENTRY_SIZE) {
+                return false;
+            }
+
+            unpacker u{data.substr(indexOffset, count * ENTRY_SIZE)};
+            index.resize(count);
+
+            for (auto &e: index) {
+                e.id = u.get<uint32_t>();
+                e.seed = u.get<uint32_t>();
+                e.offset = u.get<uint64_t>();
+                e.size = u.get<uint64_t>();
+
+                if (e.offset < HEADER_SIZE || e.offset > indexOffset || e.size > indexOffset - e.offset) {
+                    return false;
+                }
+            }
+        } catch (std::runtime_error const &) {
+            return false;
+        }
+        return true;
+    }
+
+    bool reader::read(uint32_t position, std::string &input, uint32_t &seed) const {
+        if (position >= index.size()) {
+            return false;
+        }
+        auto const &e = index[position];
+        input.assign(mapping.view().substr(e.offset, e.size));
+        seed = e.seed;
+        return true;
+    }
+}
@@ -0,0 +1,168 @@
+#include "core/ranking.h"
+#include "core/runtime_config.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    // name of the solution, or of its variant
+    std::string name(units::proto_unit const &u) {
+        return u.file.filename().string();
+    }
+
+    // zero ms is too rough to be compared
+    double ratio(size_t time, size_t base) {
+        return (double) std::max<size_t>(time, 1) / (double) std::max<size_t>(base, 1);
+    }
+
+    // two-sided p-value by normal approximation with correction for ties
+    double wilcoxon(std::vector<double> diffs) {
+        diffs.erase(std::remove(diffs.begin(), diffs.end(), 0.0), diffs.end());
+        std::sort(diffs.begin(), diffs.end(), [](double a, double b) {
+            return std::abs(a) < std::abs(b);
+        });
+
+        double n = (double) diffs.size();
+        double positive = 0;
+        double ties = 0;
+        for (size_t i = 0; i < diffs.size();) {
+            size_t j = i;
+            while (j < diffs.size() && std::abs(diffs[j]) == std::abs(diffs[i])) {
+                ++j;
+            }
+            double rank = (double) (i + j + 1) / 2; // average of ranks i + 1 .. j
+            for (size_t k = i; k < j; ++k) {
+                positive += diffs[k] > 0 ? rank : 0;
+            }
+            double t = (double) (j - i);
+            ties += t * t * t - t;
+            i = j;
+        }
+
+        double variance = n * (n + 1) * (2 * n + 1) / 24 - ties / 48;
+        if (variance <= 0) {
+            return 1;
+        }
+        double z = std::max(0.0, std::abs(positive - n * (n + 1) / 4) - 0.5) / std::sqrt(variance);
+        return std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+    }
+
+    struct standing {
+        std::string name;
+        double ratio = 1; // geometric mean
+        size_t compared = 0;
+        size_t wins = 0;
+        size_t losses = 0;
+        double pValue = 1;
+        size_t failures = 0;
+        verdict firstFailure;
+        uint32_t firstFailedTest = 0;
+        bool solution = false;
+    };
+}
+
+namespace ranking {
+
+    sample measure(test_result const &result) {
+        sample s;
+        s.id = result.id;
+        s.time = result.solutionTime;
+        s.variants = result.variants;
+        return s;
+    }
+
+    std::string report(runtime_config const &cfg, std::vector<sample> const &samples) {
+        std::vector<std::string> names{name(cfg.toTest)};
+        for (auto const &v: cfg.variants) {
+            names.push_back(name(v));
+        }
+        size_t width = 10;
+        for (auto const &n: names) {
+            width = std::max(width, n.size() + 2);
+        }
+
+        std::stringstream stream;
+        stream << std::fixed << std::setprecision(2);
+        stream << '\n' << "[*] Time of variants relative to " << names[0] << ":\n";
+        stream << std::setw(6) << "test";
+        for (auto const &n: names) {
+            stream << std::setw((int) width) << n;
+        }
+        stream << '\n';
+
+        for (auto const &s: samples) {
+            stream << std::setw(6) << s.id + 1 << std::setw((int) width - 3) << s.time << " ms";
+            for (auto const &v: s.variants) {
+                if (v.verdict == verdict::ACCEPTED) {
+                    stream << std::setw((int) width - 1) << ratio(v.time, s.time) << 'x';
+                } else {
+                    stream << std::setw((int) width) << v.verdict.toShortString();
+                }
+            }
+            stream << '\n';
+        }
+
+        std::vector<standing> standings(1);
+        standings[0].name = names[0];
+        standings[0].solution = true;
+
+        for (size_t i = 0; i < cfg.variants.size(); ++i) {
+            standing st;
+            st.name = names[i + 1];
+            double logs = 0;
+            std::vector<double> diffs;
+
+            for (auto const &s: samples) {
+                auto const &v = s.variants[i];
+                if (v.verdict == verdict::NOT_TESTED) {
+                    continue;
+                } else if (v.verdict != verdict::ACCEPTED) {
+                    if (st.failures++ == 0) {
+                        st.firstFailure = v.verdict;
+                        st.firstFailedTest = s.id + 1;
+                    }
+                    continue;
+                }
+                ++st.compared;
+                st.wins += v.time < s.time;
+                st.losses += v.time > s.time;
+                logs += std::log(ratio(v.time, s.time));
+                diffs.push_back((double) s.time - (double) v.time);
+            }
+
+            st.ratio = st.compared ? std::exp(logs / (double) st.compared) : INFINITY;
+            st.pValue = wilcoxon(diffs);
+            standings.push_back(st);
+        }
+
+        // the fastest is the first
+        std::stable_sort(standings.begin(), standings.end(), [](auto const &a, auto const &b) {
+            return a.ratio < b.ratio;
+        });
+
+        stream << '\n' << "[*] Ranking by time:\n";
+        for (size_t i = 0; i < standings.size(); ++i) {
+            auto const &st = standings[i];
+            stream << i + 1 << ". " << st.name << std::string(width - st.name.size(), ' ');
+            if (st.solution) {
+                stream << "solution to test";
+            } else if (!st.compared) {
+                stream << "no tests to compare";
+            } else {
+                stream << st.ratio << "x, " << st.wins << " wins, " << st.losses << " losses, "
+                       << st.compared - st.wins - st.losses << " ties, p = "
+                       << std::setprecision(4) << st.pValue << std::setprecision(2);
+            }
+            stream << '\n';
+        }
+
+        for (auto const &st: standings) {
+            if (st.failures) {
+                stream << st.firstFailure.toString() << " of " << st.name << " on " << st.failures
+                       << " tests, the first is test " << st.firstFailedTest << '\n';
+            }
+        }
+        return stream.str();
+    }
+}
@@ -1,4 +1,5 @@
 #include "core/run.h"
+#include <sstream>
 
 // verdict implementation
 
@@ -38,6 +39,8 @@ std::string verdict::toString() const {
             return "Interrupted";
         case SKIPPED:
             return "Skipped by limits"; // todo: rephrase
+        case DUPLICATE:
+            return "Duplicate";
         case TESTS_READ_ERROR:
             return "Reading file with tests failed";
         case GENERATOR_FAILED:
@@ -96,6 +99,22 @@ std::string verdict::toShortString() const {
 
 // execution_error implementation
 
+execution_error::execution_error(execution_error &&e) noexcept :
+        info(e.info), exitCode(e.exitCode), errCode(e.errCode),
+        explanation(std::move(e.explanation)) {
+    e.info = nullptr;
+    e.exitCode = 0;
+    e.errCode = 0;
+}
+
+execution_error &execution_error::operator=(execution_error &&e) noexcept {
+    std::swap(info, e.info);
+    std::swap(exitCode, e.exitCode);
+    std::swap(errCode, e.errCode);
+    std::swap(explanation, e.explanation);
+    return *this;
+}
+
 void execution_error::storeErrCode(size_t code) {
     errCode = code;
 }
@@ -104,8 +123,12 @@ void execution_error::storeExitCode(size_t code) {
     exitCode = code;
 }
 
+void execution_error::storeExplanation(std::string expl) {
+    explanation = std::move(expl);
+}
+
 bool execution_error::hasError() const {
-    return exitCode | errCode;
+    return (exitCode | errCode) || !explanation.empty();
 }
 
 bool execution_error::hasErrorInfo() const {
@@ -115,7 +138,9 @@ bool execution_error::hasErrorInfo() const {
 std::string execution_error::errorExplanation() const {
     std::stringstream str;
 
-    if (errCode) {
+    if (!explanation.empty()) {
+        str << explanation;
+    } else if (errCode) {
         str << errInfoExplanation();
     } else {
         str << "non-zero exit code (" << std::hex;
@@ -127,6 +152,7 @@ std::string execution_error::errorExplanation() const {
 void execution_error::clear() {
     exitCode = 0;
     errCode = 0;
+    explanation.clear();
     errInfoClear();
 }
 
@@ -141,6 +167,13 @@ void test_result::clear() {
     output.clear();
     output2.clear();
     err.clear();
+    inputHash = 0;
     verdict = verdict::ACCEPTED;
     execResult.error.clear();
+    solutionTime = solutionMemory = 0;
+    primeTime = primeMemory = 0;
+    timeLimit = 0;
+    benchTimes.clear();
+    benchMemories.clear();
+    variants.clear();
 }
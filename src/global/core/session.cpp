@@ -3,40 +3,183 @@
 #include "terminal.h"
 #include "logger.h"
 #include "core/run.h"
+#include <algorithm>
+
+namespace {
+    // how many results could be held by each worker before
+    // the preceding one is done
+    constexpr uint32_t REORDER_WINDOW_PER_WORKER = 4;
+
+    constexpr std::chrono::seconds CHECKPOINT_INTERVAL{10};
+
+    // hardest tests reported in search of the worst case
+    constexpr size_t WORST_TESTS = 5;
+}
 
 // session implementation
 
-session::session(runtime_config &cfg, class logger &logger) :
+session::session(runtime_config &cfg, class logger &logger, uint32_t workersCount) :
         cfg(cfg),
         logger(logger),
-        rand(cfg.initialSeed) {}
+        reorderWindow(std::max(1u, workersCount) * REORDER_WINDOW_PER_WORKER * cfg.multitestSize),
+        testsLimit(shardTestsCount(cfg)) {
+    if (!cfg.recordPath.empty()) {
+        uint64_t generatorHash = pack::fileHash(cfg.generator.file);
+        recorder = std::make_unique<pack::writer>(cfg.recordPath, generatorHash);
+        terminal::syncOutput("[*] Recording tests of generator ", pack::hex(generatorHash), '\n');
+    }
+    if (!cfg.corpusPath.empty()) {
+        loadCorpus();
+    }
+}
 
-bool session::newTest(decltype(rand.operator()()) &seed) {
-    std::lock_guard lck(mutex);
-    if (cancelled || testsStarted + 1 > cfg.testsCount) {
+bool session::newTest(test_result &result, bool wait) {
+    std::unique_lock lck(mutex);
+
+    auto available = [this] {
+        return !returnedTests.empty()
+               || (testsStarted < testsLimit && testsStarted - testsEmitted < reorderWindow);
+    };
+
+    if (!wait && !available()) {
+        return false;
+    }
+
+    // wait for a returned test, or for a new one which is not too far ahead
+    // of the oldest unfinished test, or until all the tests are done
+    reorderCond.wait(lck, [&] {
+        return cancelled || terminal::interrupted() || available()
+               || (testsStarted >= testsLimit && testsInFlight == 0);
+    });
+
+    if (cancelled || terminal::interrupted()) {
         return false;
     }
-    ++testsStarted;
-    seed = rand();
+
+    if (!returnedTests.empty()) {
+        result.ordinal = *returnedTests.begin();
+        returnedTests.erase(returnedTests.begin());
+    } else if (testsStarted < testsLimit) {
+        result.ordinal = testsStarted++;
+    } else {
+        return false;
+    }
+    ++testsInFlight;
+
+    result.id = testId(cfg, result.ordinal);
+    result.seed = testSeed(cfg, result.ordinal);
     return true;
 }
 
+void session::returnTest(test_result const &result) {
+    std::lock_guard lck(mutex);
+    --testsInFlight;
+
+    if (!cancelled && result.ordinal < testsLimit) {
+        returnedTests.insert(result.ordinal);
+    }
+    reorderCond.notify_all();
+}
+
+bool session::finished() {
+    std::lock_guard lck(mutex);
+    return cancelled || (testsStarted >= testsLimit && testsInFlight == 0 && returnedTests.empty());
+}
+
 void session::processedTest(test_result &result) {
     std::lock_guard lck(mutex);
+    --testsInFlight;
 
     if (cancelled) {
+        reorderCond.notify_all();
         return;
     }
 
     if (result.verdict == verdict::TESTS_OVER) {
-        testsStarted = cfg.testsCount;
+        // tests started later will not be found either
+        testsLimit = std::min(testsLimit, result.ordinal);
+    } else if (result.ordinal != testsEmitted) {
+        reorderBuffer.emplace(result.ordinal, std::move(result));
         return;
+    } else {
+        emit(result);
+    }
+
+    // release buffered results which are next in order
+    for (auto it = reorderBuffer.begin(); !cancelled && it != reorderBuffer.end();) {
+        if (it->first >= testsLimit) {
+            it = reorderBuffer.erase(it);
+        } else if (it->first == testsEmitted) {
+            emit(it->second);
+            it = reorderBuffer.erase(it);
+        } else {
+            break;
+        }
     }
 
-    uint32_t testId = ++testsDone;
+    if (cancelled) {
+        reorderBuffer.clear();
+    }
+    reorderCond.notify_all();
+}
+
+void session::emit(test_result &result) {
+    ++testsEmitted;
+    ++testsDone;
+
+    if (cfg.dedup && result.verdict != verdict::DUPLICATE && isDuplicate(result)) {
+        result.verdict = verdict::DUPLICATE;
+    }
+
+    uint32_t testId = result.id + 1;
     totalTime += result.execResult.time;
+
+    if (result.verdict == verdict::DUPLICATE) {
+        ++duplicates;
+    }
+
+    // only complete inputs, each of them once
+    if (recorder && result.verdict != verdict::NOT_TESTED && result.verdict != verdict::DUPLICATE
+        && result.verdict != verdict::GENERATOR_FAILED && result.verdict != verdict::GENERATOR_RE
+        && !recorder->write(result.id, result.seed, result.input)) {
+        terminal::syncOutput("[!] Unable to record a test, recording stopped\n");
+        recorder.reset();
+    }
     maxTime = std::max(maxTime, result.execResult.time);
 
+    if (!cfg.sizes.empty() && (result.verdict == verdict::ACCEPTED || result.verdict.isOrdinaryError())) {
+        measurements.push_back(complexity::measure(cfg, result));
+    }
+
+    if (!result.benchTimes.empty()) {
+        benchmarks.push_back(benchmark::measure(result));
+    }
+
+    if (!result.variants.empty()) {
+        comparisons.push_back(ranking::measure(result));
+    }
+
+    bool checked = result.verdict == verdict::ACCEPTED || result.verdict.isOrdinaryError();
+    if (cfg.worst != worst_case::NONE && checked) {
+        keepWorst(worstTests, result, cfg.worst, WORST_TESTS);
+    }
+
+    // grouped tests are timed only together
+    if (cfg.displayStats && checked && cfg.multitestSize == 1) {
+        solutionTimes.add(result.solutionTime);
+        solutionMemories.add(result.solutionMemory);
+        if (!cfg.prime.empty()) {
+            primeTimes.add(result.primeTime);
+            primeMemories.add(result.primeMemory);
+        }
+        if (cfg.worst != worst_case::TIME) {
+            keepWorst(slowestTests, result, worst_case::TIME, LEADERBOARD_TESTS);
+        }
+        if (cfg.worst != worst_case::MEMORY) {
+            keepWorst(hungriestTests, result, worst_case::MEMORY, LEADERBOARD_TESTS);
+        }
+    }
+
     // write a result to terminal
     terminal::writeTestResult(cfg, result, testId);
 
@@ -66,10 +209,148 @@ void session::processedTest(test_result &result) {
         auto status = logger.writeTest(cfg, result, testId, cfg.pausing);
         processExpl(status);
         solutionBroken = true;
+        if (cfg.shrink && !firstFailure) {
+            // execution error is not needed, it is made again by shrinking
+            auto &failure = firstFailure.emplace();
+            failure.ordinal = result.ordinal;
+            failure.id = result.id;
+            failure.seed = result.seed;
+            failure.verdict = result.verdict;
+            failure.input = result.input;
+        }
         if (cfg.pausing && !cancelled) {
             terminal::pause();
         }
     }
+
+    if (!cancelled) {
+        testsCompleted = testsEmitted;
+    }
+
+    if (std::chrono::steady_clock::now() - lastCheckpoint >= CHECKPOINT_INTERVAL) {
+        storeCheckpoint();
+    }
+}
+
+void session::keepWorst(std::vector<test_result> &tests, test_result const &result, worst_case kind, size_t limit) {
+    auto fitness = [kind](test_result const &t) {
+        return kind == worst_case::TIME ? t.solutionTime : t.solutionMemory;
+    };
+    if (tests.size() == limit && fitness(result) <= fitness(tests.back())) {
+        return;
+    }
+
+    // execution result is of the solution, not of the last unit
+    test_result kept;
+    kept.ordinal = result.ordinal;
+    kept.id = result.id;
+    kept.seed = result.seed;
+    kept.verdict = result.verdict;
+    kept.input = result.input;
+    kept.execResult.time = kept.solutionTime = result.solutionTime;
+    kept.execResult.memory = kept.solutionMemory = result.solutionMemory;
+
+    // equal ones stay in order of tests
+    auto it = std::upper_bound(tests.begin(), tests.end(), kept, [&](auto const &a, auto const &b) {
+        return fitness(a) > fitness(b);
+    });
+    tests.insert(it, std::move(kept));
+    if (tests.size() > limit) {
+        tests.pop_back();
+    }
+}
+
+bool session::isDuplicate(test_result const &result) {
+    // input was hashed by generator
+    if (result.verdict == verdict::NOT_TESTED || result.verdict.isCriticalError()) {
+        return false;
+    }
+    if (!seenInputs.insert(result.inputHash).second) {
+        return true;
+    }
+    if (corpus.is_open()) {
+        corpus.write((char const *) &result.inputHash, sizeof(result.inputHash));
+        corpus.flush();
+    }
+    return false;
+}
+
+void session::loadCorpus() {
+    std::ifstream in(cfg.corpusPath, std::ios::binary);
+    uint64_t hash;
+
+    while (in.read((char *) &hash, sizeof(hash))) {
+        seenInputs.insert(hash);
+    }
+
+    corpus.open(cfg.corpusPath, std::ios::binary | std::ios::app);
+    if (!corpus.is_open()) {
+        throw std::runtime_error("[!] Unable to open corpus " + cfg.corpusPath.string());
+    }
+}
+
+void session::restore(checkpoint const &c) {
+    std::lock_guard lck(mutex);
+    testsStarted = testsEmitted = testsCompleted = testsDone = c.testsCompleted;
+    totalTime = c.totalTime;
+    maxTime = c.maxTime;
+    solutionBroken = c.solutionBroken;
+}
+
+void session::finish() {
+    std::lock_guard lck(mutex);
+
+    if (testsCompleted >= testsLimit) {
+        checkpoint::remove(cfg);
+    } else {
+        storeCheckpoint();
+    }
+}
+
+void session::storeCheckpoint() {
+    checkpoint c;
+    c.initialSeed = cfg.initialSeed;
+    c.testsCompleted = testsCompleted;
+    c.totalTime = totalTime;
+    c.maxTime = maxTime;
+    c.solutionBroken = solutionBroken;
+    std::tie(c.logPath, c.logSize) = logger.position();
+
+    if (!c.save(cfg)) {
+        terminal::syncOutput("[!] Unable to store a checkpoint\n");
+    }
+    lastCheckpoint = std::chrono::steady_clock::now();
+}
+
+uint32_t session::shardTestsCount(runtime_config const &cfg) {
+    uint32_t total = cfg.replay.empty() ? cfg.testsCount : (uint32_t) cfg.replay.size();
+    if (total <= cfg.shardIndex) {
+        return 0;
+    }
+    return (total - cfg.shardIndex + cfg.shardsCount - 1) / cfg.shardsCount;
+}
+
+uint32_t session::testId(runtime_config const &cfg, uint32_t ordinal) {
+    // shards take every N-th test, so they are disjoint
+    uint32_t index = ordinal * cfg.shardsCount + cfg.shardIndex;
+    return cfg.replay.empty() ? index : cfg.replay[index].id;
+}
+
+uint32_t session::testSeed(runtime_config const &cfg, uint32_t ordinal) {
+    if (cfg.replay.empty()) {
+        return deriveSeed(cfg.initialSeed, testId(cfg, ordinal));
+    }
+    auto const &entry = cfg.replay[ordinal * cfg.shardsCount + cfg.shardIndex];
+    return entry.seed.value_or(deriveSeed(cfg.initialSeed, entry.id));
+}
+
+uint32_t session::deriveSeed(uint32_t initialSeed, uint32_t testId) {
+    // splitmix64 finalizer
+    uint64_t z = ((uint64_t) initialSeed << 32 | testId) + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z = z ^ (z >> 31);
+    return (uint32_t) (z >> 32);
 }
 
 void session::cancel() {
@@ -0,0 +1,292 @@
+#include "core/shrinker.h"
+#include "core/runtime_config.h"
+#include "core/chain.h"
+#include "core/run.h"
+#include "terminal.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+    // runs of the solution spent on a single test at most
+    constexpr uint32_t MAX_SHRINK_RUNS = 20000;
+
+    // token of a test which keeps its line
+    struct token {
+        std::string text;
+        size_t line = 0;
+    };
+
+    // runs candidates in parallel and finds the first failing one
+    class search {
+    public:
+        search(runtime_config &cfg, memory_budget &budget, uint32_t workersCount, test_result const &failed) :
+                cfg(cfg), budget(budget), workersCount(std::max(1u, workersCount)), failed(failed) {}
+
+        // index of the first candidate which fails, or count if there is none
+        size_t first(size_t count, std::function<std::string(size_t)> const &make) {
+            std::atomic<size_t> next{0};
+            std::atomic<size_t> best{count};
+
+            auto work = [&] {
+                chain c(cfg, budget);
+                test_result result;
+
+                for (size_t i = next++; i < best && !exhausted(); i = next++) {
+                    if (fails(c, result, make(i))) {
+                        // candidates after the found one are not needed anymore
+                        size_t prev = best;
+                        while (i < prev && !best.compare_exchange_weak(prev, i)) {}
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads(std::min<size_t>(workersCount, count));
+            for (auto &t: threads) {
+                t = std::thread(work);
+            }
+            for (auto &t: threads) {
+                t.join();
+            }
+
+            // indexes before the found one were all tried, unless search stopped
+            return best;
+        }
+
+        bool exhausted() const {
+            return runs >= MAX_SHRINK_RUNS || terminal::interrupted();
+        }
+
+        // run the input once more to get outputs of the shrunk test
+        void rerun(test_result &result, std::string const &input) {
+            chain c(cfg, budget);
+            fails(c, result, input);
+        }
+
+    private:
+        bool fails(chain const &c, test_result &result, std::string const &input) {
+            result.clear();
+            result.ordinal = failed.ordinal;
+            result.id = failed.id;
+            result.seed = failed.seed;
+            result.input = input;
+
+            c.check(cfg, result);
+            ++runs;
+            return result.verdict == failed.verdict;
+        }
+
+        runtime_config &cfg;
+        memory_budget &budget;
+        uint32_t workersCount;
+        test_result const &failed;
+        std::atomic<uint32_t> runs{0};
+    };
+
+    // drop chunks of parts while the rest still fails, ddmin-like
+    template<typename T, typename Render>
+    bool reduce(search &s, std::vector<T> &parts, Render const &render) {
+        bool changed = false;
+        size_t n = 2;
+
+        while (!parts.empty() && !s.exhausted()) {
+            n = std::min(n, parts.size());
+            size_t chunk = (parts.size() + n - 1) / n;
+            size_t count = (parts.size() + chunk - 1) / chunk;
+
+            auto without = [&](size_t i) {
+                std::vector<T> rest;
+                rest.reserve(parts.size());
+                rest.insert(rest.end(), parts.begin(), parts.begin() + (long) (i * chunk));
+                rest.insert(rest.end(), parts.begin() + (long) std::min(parts.size(), (i + 1) * chunk), parts.end());
+                return rest;
+            };
+
+            size_t found = s.first(count, [&](size_t i) { return render(without(i)); });
+
+            if (found < count) {
+                parts = without(found);
+                n = std::max<size_t>(n - 1, 2);
+                changed = true;
+            } else if (chunk == 1) {
+                break;
+            } else {
+                n *= 2;
+            }
+        }
+        return changed;
+    }
+
+    std::vector<std::string> splitLines(std::string const &input) {
+        std::vector<std::string> lines;
+        size_t begin = 0;
+        while (begin < input.size()) {
+            size_t end = input.find('\n', begin);
+            end = end == std::string::npos ? input.size() : end + 1;
+            lines.emplace_back(input, begin, end - begin);
+            begin = end;
+        }
+        return lines;
+    }
+
+    std::string joinLines(std::vector<std::string> const &lines) {
+        std::string input;
+        for (auto const &line: lines) {
+            input += line;
+        }
+        return input;
+    }
+
+    bool reduceLines(search &s, std::string &input) {
+        auto lines = splitLines(input);
+        if (!reduce(s, lines, joinLines)) {
+            return false;
+        }
+        input = joinLines(lines);
+        return true;
+    }
+
+    // tokens are joined by spaces, lines are kept even if they become empty
+    bool reduceTokens(search &s, std::string &input) {
+        auto lines = splitLines(input);
+        bool trailingBreak = !input.empty() && input.back() == '\n';
+
+        std::vector<token> tokens;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            size_t pos = 0;
+            auto const &line = lines[i];
+            while ((pos = line.find_first_not_of(" \t\r\n", pos)) != std::string::npos) {
+                size_t end = std::min(line.find_first_of(" \t\r\n", pos), line.size());
+                tokens.push_back({line.substr(pos, end - pos), i});
+                pos = end;
+            }
+        }
+
+        auto render = [&](std::vector<token> const &kept) {
+            std::string result;
+            auto it = kept.begin();
+            for (size_t i = 0; i < lines.size(); ++i) {
+                for (bool first = true; it != kept.end() && it->line == i; ++it, first = false) {
+                    result += first ? "" : " ";
+                    result += it->text;
+                }
+                if (i + 1 < lines.size() || trailingBreak) {
+                    result += '\n';
+                }
+            }
+            return result;
+        };
+
+        if (!reduce(s, tokens, render)) {
+            return false;
+        }
+        input = render(tokens);
+        return true;
+    }
+
+    // replace numbers by zero or their halves, one at a time
+    bool reduceNumbers(search &s, std::string &input) {
+        bool changed = false;
+        size_t from = 0; // keep on with the last changed number
+
+        while (!s.exhausted()) {
+            struct replacement {
+                size_t pos, length;
+                std::string text;
+            };
+            std::vector<replacement> candidates;
+
+            for (size_t pos = 0; pos < input.size();) {
+                // only whole tokens
+                if (pos > 0 && !isspace((unsigned char) input[pos - 1])) {
+                    ++pos;
+                    continue;
+                }
+
+                size_t end = pos;
+                end += end < input.size() && input[end] == '-';
+                while (end < input.size() && isdigit((unsigned char) input[end])) {
+                    ++end;
+                }
+
+                int64_t value;
+                auto [ptr, ec] = std::from_chars(input.data() + pos, input.data() + end, value);
+                if (ec != std::errc() || ptr != input.data() + end
+                    || (end < input.size() && !isspace((unsigned char) input[end]))) {
+                    pos = std::max(pos + 1, end);
+                    continue;
+                }
+
+                std::vector<int64_t> simpler = {0};
+                auto add = [&](int64_t v) {
+                    if (std::find(simpler.begin(), simpler.end(), v) == simpler.end()) {
+                        simpler.push_back(v);
+                    }
+                };
+                add(value / 2);
+                // the least value has no positive counterpart
+                if (value < 0 && value != std::numeric_limits<int64_t>::min()) {
+                    add(-value);
+                }
+                for (int64_t v: simpler) {
+                    if (v != value) {
+                        candidates.push_back({pos, end - pos, std::to_string(v)});
+                    }
+                }
+                pos = end;
+            }
+
+            // start with the number which was changed last
+            auto mid = std::find_if(candidates.begin(), candidates.end(),
+                                    [&](auto const &c) { return c.pos >= from; });
+            std::rotate(candidates.begin(), mid, candidates.end());
+
+            auto apply = [&](size_t i) {
+                auto const &c = candidates[i];
+                return input.substr(0, c.pos) + c.text + input.substr(c.pos + c.length);
+            };
+
+            size_t found = s.first(candidates.size(), apply);
+            if (found == candidates.size()) {
+                break;
+            }
+            input = apply(found);
+            from = candidates[found].pos;
+            changed = true;
+        }
+        return changed;
+    }
+}
+
+namespace shrinker {
+
+    bool shrink(runtime_config &cfg, memory_budget &budget, uint32_t workersCount, test_result &result) {
+        search s(cfg, budget, workersCount, result);
+        std::string input = result.input;
+
+        bool changed = true;
+        while (changed && !s.exhausted()) {
+            changed = reduceLines(s, input);
+            changed |= reduceTokens(s, input);
+            changed |= reduceNumbers(s, input);
+        }
+
+        if (input == result.input || terminal::interrupted()) {
+            return false;
+        }
+
+        test_result shrunk;
+        s.rerun(shrunk, input);
+        if (!(shrunk.verdict == result.verdict)) {
+            // solution is flaky, the failure is not reproduced
+            return false;
+        }
+        result = std::move(shrunk);
+        return true;
+    }
+}
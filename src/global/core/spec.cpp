@@ -0,0 +1,519 @@
+#include "core/spec.h"
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <numeric>
+#include <charconv>
+#include <cctype>
+
+namespace {
+    using atom = spec::atom;
+    using item = spec::item;
+    using statement = spec::statement;
+
+    // statements are nested by repeat
+    constexpr size_t MAX_DEPTH = 16;
+
+    // vertices of a graph, so both ends of an edge fit in one key
+    constexpr int64_t MAX_GRAPH_VERTICES = UINT32_MAX;
+
+    // splitmix64, so tests are the same on any platform
+    class rng {
+    public:
+        explicit rng(uint32_t seed) : state(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        // uniform in [lo, hi], lo <= hi
+        int64_t range(int64_t lo, int64_t hi) {
+            uint64_t size = (uint64_t) hi - (uint64_t) lo + 1;
+            if (size == 0) {
+                return (int64_t) next();
+            }
+
+            // reject the values of incomplete last interval
+            uint64_t limit = UINT64_MAX - UINT64_MAX % size;
+            uint64_t x;
+            do {
+                x = next();
+            } while (x >= limit);
+            return (int64_t) ((uint64_t) lo + x % size);
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    class parser {
+    public:
+        explicit parser(spec::path file) : file(std::move(file)) {}
+
+        std::vector<statement> parseBlock(std::istream &in, size_t depth) {
+            std::vector<statement> block;
+            std::string line;
+
+            while (std::getline(in, line)) {
+                ++lineNumber;
+                tokens = tokenize(line);
+                pos = 0;
+
+                if (tokens.empty()) {
+                    continue;
+                } else if (tokens[0] == "end") {
+                    if (depth == 0) {
+                        fail("unexpected end");
+                    }
+                    pos = 1;
+                    expectEnd();
+                    return block;
+                }
+                block.push_back(parseStatement(in, depth));
+            }
+
+            if (depth != 0) {
+                fail("repeat is not closed by end");
+            }
+            return block;
+        }
+
+        size_t variablesCount() const {
+            return variables.size();
+        }
+
+    private:
+        statement parseStatement(std::istream &in, size_t depth) {
+            statement s;
+            std::string const &head = take();
+
+            if (head == "line") {
+                s.k = statement::kind::LINE;
+                while (pos < tokens.size()) {
+                    s.items.push_back(parseItem());
+                }
+
+            } else if (head == "tree") {
+                s.k = statement::kind::TREE;
+                s.args = {parseAtom()};
+                expectEnd();
+
+            } else if (head == "graph") {
+                s.k = statement::kind::GRAPH;
+                s.args = {parseAtom(), parseAtom()};
+                expectEnd();
+
+            } else if (head == "repeat") {
+                if (depth + 1 >= MAX_DEPTH) {
+                    fail("repeat is nested too deep");
+                }
+                s.k = statement::kind::REPEAT;
+                s.args = {parseAtom()};
+                expectEnd();
+                s.body = parseBlock(in, depth + 1);
+
+            } else if (pos < tokens.size() && tokens[pos] == "=") {
+                ++pos;
+                if (!isName(head)) {
+                    fail("invalid name of variable: " + head);
+                }
+                s.k = statement::kind::ASSIGN;
+                s.items = {parseItem()};
+
+                if (s.items[0].k != item::kind::VALUE && s.items[0].k != item::kind::INT) {
+                    fail("variable must be a number");
+                }
+                expectEnd();
+
+                // defined after the value, so "n = int 1 n" refers to the previous n
+                auto [it, inserted] = variables.emplace(head, variables.size());
+                s.variable = it->second;
+
+            } else {
+                fail("unknown statement: " + head);
+            }
+            return s;
+        }
+
+        item parseItem() {
+            item i;
+            std::string const &head = take();
+
+            if (head == "int") {
+                i.k = item::kind::INT;
+                i.args = {parseAtom(), parseAtom()};
+
+            } else if (head == "array") {
+                i.k = item::kind::ARRAY;
+                i.args = {parseAtom(), parseAtom(), parseAtom()};
+
+            } else if (head == "perm") {
+                i.k = item::kind::PERM;
+                i.args = {parseAtom()};
+
+            } else if (head == "string") {
+                i.k = item::kind::STRING;
+                i.args = {parseAtom()};
+                i.alphabet = parseAlphabet(take());
+
+            } else {
+                --pos;
+                i.k = item::kind::VALUE;
+                i.args = {parseAtom()};
+            }
+            return i;
+        }
+
+        atom parseAtom() {
+            std::string const &token = take();
+            atom a;
+
+            auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), a.value);
+            if (ec == std::errc() && ptr == token.data() + token.size()) {
+                return a;
+            }
+
+            auto it = variables.find(token);
+            if (it == variables.end()) {
+                fail("unknown variable: " + token);
+            }
+            a.variable = true;
+            a.value = (int64_t) it->second;
+            return a;
+        }
+
+        // ranges like a-z are expanded
+        std::string parseAlphabet(std::string const &token) {
+            std::string alphabet;
+
+            for (size_t i = 0; i < token.size(); ++i) {
+                if (i + 2 < token.size() && token[i + 1] == '-' && token[i] <= token[i + 2]) {
+                    for (char c = token[i]; c != token[i + 2]; ++c) {
+                        alphabet += c;
+                    }
+                    alphabet += token[i + 2];
+                    i += 2;
+                } else {
+                    alphabet += token[i];
+                }
+            }
+
+            std::sort(alphabet.begin(), alphabet.end());
+            alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+            return alphabet;
+        }
+
+        std::string const &take() {
+            if (pos >= tokens.size()) {
+                fail("unexpected end of line");
+            }
+            return tokens[pos++];
+        }
+
+        void expectEnd() {
+            if (pos < tokens.size()) {
+                fail("unexpected " + tokens[pos]);
+            }
+        }
+
+        static bool isName(std::string const &token) {
+            static const std::unordered_set<std::string> keywords = {
+                    "line", "tree", "graph", "repeat", "end", "int", "array", "perm", "string"
+            };
+            return !token.empty() && (isalpha((unsigned char) token[0]) || token[0] == '_')
+                   && std::all_of(token.begin(), token.end(), [](char c) {
+                       return isalnum((unsigned char) c) || c == '_';
+                   })
+                   && !keywords.count(token);
+        }
+
+        static std::vector<std::string> tokenize(std::string const &line) {
+            std::stringstream stream(line.substr(0, line.find('#')));
+            std::vector<std::string> result;
+
+            for (std::string token; stream >> token;) {
+                result.push_back(std::move(token));
+            }
+            return result;
+        }
+
+        [[noreturn]] void fail(std::string const &message) const {
+            throw std::runtime_error(
+                    "[!] " + file.string() + ":" + std::to_string(lineNumber) + ": " + message);
+        }
+
+        spec::path file;
+        std::unordered_map<std::string, size_t> variables;
+        std::vector<std::string> tokens;
+        size_t pos = 0;
+        size_t lineNumber = 0;
+    };
+
+    class evaluator {
+    public:
+        evaluator(uint32_t seed, size_t variablesCount, std::string &out) :
+                random(seed), variables(variablesCount), out(out) {}
+
+        bool run(std::vector<statement> const &block) {
+            for (auto const &s: block) {
+                if (!run(s)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::string error;
+
+    private:
+        bool run(statement const &s) {
+            switch (s.k) {
+                case statement::kind::ASSIGN: {
+                    int64_t value;
+                    if (!scalar(s.items[0], value)) {
+                        return false;
+                    }
+                    variables[s.variable] = value;
+                    return true;
+                }
+                case statement::kind::LINE: {
+                    for (size_t i = 0; i < s.items.size(); ++i) {
+                        if (i != 0) {
+                            out += ' ';
+                        }
+                        if (!print(s.items[i])) {
+                            return false;
+                        }
+                    }
+                    out += '\n';
+                    return true;
+                }
+                case statement::kind::TREE:
+                    return tree(value(s.args[0]));
+
+                case statement::kind::GRAPH:
+                    return graph(value(s.args[0]), value(s.args[1]));
+
+                case statement::kind::REPEAT: {
+                    int64_t count = value(s.args[0]);
+                    for (int64_t i = 0; i < count; ++i) {
+                        if (!run(s.body)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+            }
+            return true;
+        }
+
+        bool scalar(item const &i, int64_t &result) {
+            if (i.k == item::kind::VALUE) {
+                result = value(i.args[0]);
+                return true;
+            }
+            return randomInt(value(i.args[0]), value(i.args[1]), result);
+        }
+
+        bool print(item const &i) {
+            switch (i.k) {
+                case item::kind::VALUE:
+                    [[fallthrough]];
+                case item::kind::INT: {
+                    int64_t result;
+                    if (!scalar(i, result)) {
+                        return false;
+                    }
+                    write(result);
+                    return true;
+                }
+                case item::kind::ARRAY: {
+                    int64_t size = value(i.args[0]), lo = value(i.args[1]), hi = value(i.args[2]);
+                    if (!length(size)) {
+                        return false;
+                    }
+                    for (int64_t k = 0; k < size; ++k) {
+                        int64_t result;
+                        if (!randomInt(lo, hi, result)) {
+                            return false;
+                        }
+                        if (k != 0) {
+                            out += ' ';
+                        }
+                        write(result);
+                    }
+                    return true;
+                }
+                case item::kind::PERM: {
+                    int64_t size = value(i.args[0]);
+                    if (!length(size)) {
+                        return false;
+                    }
+                    auto p = permutation(size);
+                    for (size_t k = 0; k < p.size(); ++k) {
+                        if (k != 0) {
+                            out += ' ';
+                        }
+                        write(p[k]);
+                    }
+                    return true;
+                }
+                case item::kind::STRING: {
+                    int64_t size = value(i.args[0]);
+                    if (!length(size)) {
+                        return false;
+                    }
+                    for (int64_t k = 0; k < size; ++k) {
+                        out += i.alphabet[(size_t) random.range(0, (int64_t) i.alphabet.size() - 1)];
+                    }
+                    return true;
+                }
+            }
+            return true;
+        }
+
+        // random labels and random parents, so both shape and numbering are random
+        bool tree(int64_t n) {
+            if (n < 1) {
+                return fail("tree must have at least one vertex");
+            }
+            auto label = permutation(n);
+
+            for (int64_t v = 1; v < n; ++v) {
+                int64_t parent = random.range(0, v - 1);
+                if (random.next() & 1) {
+                    edge(label[(size_t) v], label[(size_t) parent]);
+                } else {
+                    edge(label[(size_t) parent], label[(size_t) v]);
+                }
+            }
+            return true;
+        }
+
+        bool graph(int64_t n, int64_t m) {
+            if (n < 1 || m < 0) {
+                return fail("graph must have at least one vertex");
+            }
+            if (n > MAX_GRAPH_VERTICES) {
+                return fail("too many vertices for a graph: " + std::to_string(n));
+            }
+            uint64_t pairsCount = (uint64_t) n * (uint64_t) (n - 1) / 2;
+            if ((uint64_t) m > pairsCount) {
+                return fail("too many edges for a simple graph: " + std::to_string(m));
+            }
+
+            // dense graph is a random part of all the pairs
+            if (2 * (uint64_t) m > pairsCount) {
+                std::vector<std::pair<int64_t, int64_t>> pairs;
+                for (int64_t u = 1; u <= n; ++u) {
+                    for (int64_t v = u + 1; v <= n; ++v) {
+                        pairs.emplace_back(u, v);
+                    }
+                }
+                for (size_t i = 0; i < (size_t) m; ++i) {
+                    std::swap(pairs[i], pairs[(size_t) random.range((int64_t) i, (int64_t) pairs.size() - 1)]);
+                    auto [u, v] = pairs[i];
+                    if (random.next() & 1) {
+                        std::swap(u, v);
+                    }
+                    edge(u, v);
+                }
+                return true;
+            }
+
+            // sparse one is made of distinct random pairs
+            std::unordered_set<uint64_t> edges;
+            edges.reserve((size_t) m);
+
+            while ((int64_t) edges.size() < m) {
+                int64_t u = random.range(1, n), v = random.range(1, n);
+                if (u == v) {
+                    continue;
+                }
+                uint64_t key = (uint64_t) std::min(u, v) << 32 | (uint64_t) std::max(u, v);
+                if (edges.insert(key).second) {
+                    edge(u, v);
+                }
+            }
+            return true;
+        }
+
+        std::vector<int64_t> permutation(int64_t n) {
+            std::vector<int64_t> p((size_t) n);
+            std::iota(p.begin(), p.end(), 1);
+
+            for (size_t i = p.size(); i > 1; --i) {
+                std::swap(p[i - 1], p[(size_t) random.range(0, (int64_t) i - 1)]);
+            }
+            return p;
+        }
+
+        void edge(int64_t u, int64_t v) {
+            write(u);
+            out += ' ';
+            write(v);
+            out += '\n';
+        }
+
+        bool randomInt(int64_t lo, int64_t hi, int64_t &result) {
+            if (lo > hi) {
+                return fail("empty range " + std::to_string(lo) + ".." + std::to_string(hi));
+            }
+            result = random.range(lo, hi);
+            return true;
+        }
+
+        bool length(int64_t size) {
+            return size >= 0 || fail("negative length " + std::to_string(size));
+        }
+
+        int64_t value(atom const &a) const {
+            return a.variable ? variables[(size_t) a.value] : a.value;
+        }
+
+        void write(int64_t value) {
+            char buf[24];
+            auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, ptr);
+        }
+
+        bool fail(std::string message) {
+            error = std::move(message);
+            return false;
+        }
+
+        rng random;
+        std::vector<int64_t> variables;
+        std::string &out;
+    };
+}
+
+// spec implementation
+
+spec spec::parse(path const &file) {
+    std::ifstream in(file);
+    if (!in.is_open()) {
+        throw std::runtime_error("[!] Unable to read " + file.string());
+    }
+
+    parser p(file);
+    spec result;
+    result.statements = p.parseBlock(in, 0);
+    result.variablesCount = p.variablesCount();
+    return result;
+}
+
+bool spec::generate(uint32_t seed, std::string &test, std::string &error) const {
+    evaluator e(seed, variablesCount, test);
+
+    if (!e.run(statements)) {
+        error = std::move(e.error);
+        return false;
+    }
+    return true;
+}
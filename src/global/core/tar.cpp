@@ -0,0 +1,164 @@
+#include "core/tar.h"
+#include <cstdint>
+
+namespace {
+    constexpr size_t BLOCK_SIZE = 512;
+
+    // ustar header fields
+    constexpr size_t NAME_OFFSET = 0;
+    constexpr size_t NAME_SIZE = 100;
+    constexpr size_t SIZE_OFFSET = 124;
+    constexpr size_t SIZE_SIZE = 12;
+    constexpr size_t CHECKSUM_OFFSET = 148;
+    constexpr size_t CHECKSUM_SIZE = 8;
+    constexpr size_t TYPE_OFFSET = 156;
+    constexpr size_t MAGIC_OFFSET = 257;
+    constexpr size_t PREFIX_OFFSET = 345;
+    constexpr size_t PREFIX_SIZE = 155;
+
+    constexpr std::string_view USTAR_MAGIC = "ustar";
+
+    // field is terminated by zero or by its end
+    std::string_view field(std::string_view header, size_t offset, size_t size) {
+        std::string_view f = header.substr(offset, size);
+        return f.substr(0, f.find('\0'));
+    }
+
+    bool parseOctal(std::string_view f, uint64_t &result) {
+        result = 0;
+        bool digits = false;
+
+        for (char c: f) {
+            if (c >= '0' && c <= '7') {
+                result = result * 8 + (uint64_t) (c - '0');
+                digits = true;
+            } else if (c != ' ' || digits) {
+                break;
+            }
+        }
+        return digits;
+    }
+
+    // large sizes are stored as big-endian binary with the highest bit set
+    bool parseSize(std::string_view header, uint64_t &result) {
+        std::string_view f = header.substr(SIZE_OFFSET, SIZE_SIZE);
+
+        if ((unsigned char) f[0] & 0x80) {
+            result = 0;
+            for (size_t i = 1; i < f.size(); ++i) {
+                result = result << 8 | (unsigned char) f[i];
+            }
+            return true;
+        }
+        return parseOctal(field(header, SIZE_OFFSET, SIZE_SIZE), result);
+    }
+
+    // checksum is counted as if its own field is filled by spaces
+    bool validChecksum(std::string_view header) {
+        uint64_t expected;
+        if (!parseOctal(field(header, CHECKSUM_OFFSET, CHECKSUM_SIZE), expected)) {
+            return false;
+        }
+
+        uint64_t sum = 0;
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            bool inChecksum = i >= CHECKSUM_OFFSET && i < CHECKSUM_OFFSET + CHECKSUM_SIZE;
+            sum += inChecksum ? (uint64_t) ' ' : (unsigned char) header[i];
+        }
+        return sum == expected;
+    }
+
+    // value of "path" record of pax extended header
+    std::string paxPath(std::string_view data) {
+        std::string path;
+
+        // records are "<length> <key>=<value>\n"
+        for (size_t pos = 0; pos < data.size();) {
+            size_t length = 0;
+            size_t space = pos;
+            while (space < data.size() && data[space] >= '0' && data[space] <= '9') {
+                length = length * 10 + (size_t) (data[space++] - '0');
+            }
+            if (length == 0 || space >= data.size() || pos + length > data.size()) {
+                break;
+            }
+
+            std::string_view record = data.substr(space + 1, pos + length - space - 2);
+            if (record.substr(0, 5) == "path=") {
+                path = record.substr(5);
+            }
+            pos += length;
+        }
+        return path;
+    }
+
+    bool isZeroBlock(std::string_view block) {
+        return block.find_first_not_of('\0') == std::string_view::npos;
+    }
+}
+
+// tar_archive implementation
+
+bool tar_archive::open(std::filesystem::path const &file) {
+    if (!mapping.open(file)) {
+        return false;
+    }
+    std::string_view data = mapping.view();
+    std::string longName; // of the next member, set by extension headers
+
+    // otherwise any file would be read as an empty archive
+    if (data.size() < BLOCK_SIZE || !validChecksum(data.substr(0, BLOCK_SIZE))
+        || data.substr(MAGIC_OFFSET, USTAR_MAGIC.size()) != USTAR_MAGIC) {
+        return false;
+    }
+
+    for (size_t pos = 0; pos + BLOCK_SIZE <= data.size();) {
+        std::string_view header = data.substr(pos, BLOCK_SIZE);
+
+        // archive ends by zero blocks
+        if (isZeroBlock(header)) {
+            break;
+        }
+
+        uint64_t size;
+        if (!validChecksum(header) || !parseSize(header, size)
+            || size > data.size() - pos - BLOCK_SIZE) {
+            return false;
+        }
+        std::string_view content = data.substr(pos + BLOCK_SIZE, size);
+        pos += BLOCK_SIZE + (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+
+        switch (header[TYPE_OFFSET]) {
+            case 'L': // GNU long name
+                longName = field(content, 0, content.size());
+                break;
+
+            case 'x': // pax extended header
+                longName = paxPath(content);
+                break;
+
+            case '0':
+            case '\0': {
+                std::string name = longName;
+
+                if (name.empty()) {
+                    std::string_view prefix;
+                    if (header.substr(MAGIC_OFFSET, USTAR_MAGIC.size()) == USTAR_MAGIC) {
+                        prefix = field(header, PREFIX_OFFSET, PREFIX_SIZE);
+                    }
+                    name = std::string(prefix) + (prefix.empty() ? "" : "/")
+                           + std::string(field(header, NAME_OFFSET, NAME_SIZE));
+                }
+                members.push_back({std::move(name), content});
+                longName.clear();
+                break;
+            }
+
+            default:
+                // directories, links and others are not tests
+                longName.clear();
+                break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,134 @@
+#include "core/test_stream.h"
+#include "core/tests_file.h"
+#include "terminal.h"
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+
+namespace {
+    // how many tests are read ahead of workers
+    constexpr size_t BUFFERED_TESTS = 64;
+    constexpr size_t BUFFERED_BYTES = 64 * 1024 * 1024;
+
+    constexpr std::chrono::milliseconds POLL_INTERVAL{100};
+}
+
+struct test_stream::state {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::map<uint32_t, std::string> tests;
+    size_t bytes = 0;
+    uint32_t read = 0; // tests read from the stream, including dropped ones
+    bool ended = false;
+    bool stopped = false;
+
+    std::ifstream file;
+    std::istream *in = nullptr;
+};
+
+// test_stream implementation
+
+test_stream::test_stream(path const &file, uint32_t shardIndex, uint32_t shardsCount) :
+        s(std::make_shared<state>()) {
+    if (file == "-") {
+        s->in = &std::cin;
+    } else {
+        s->file.open(file, std::ios::binary);
+        if (!s->file.is_open()) {
+            throw std::runtime_error("[!] Unable to open " + file.string());
+        }
+        s->in = &s->file;
+    }
+
+    std::thread([s = s, shardIndex, shardsCount] {
+        std::string data; // of the tests which are not complete yet
+        std::string line;
+        bool eof = false;
+
+        auto push = [&](std::string test) {
+            std::unique_lock lck(s->mutex);
+            uint32_t id = s->read;
+
+            if (id % shardsCount == shardIndex) {
+                s->cond.wait(lck, [&] {
+                    return s->stopped || (s->tests.size() < BUFFERED_TESTS && s->bytes < BUFFERED_BYTES);
+                });
+                if (s->stopped) {
+                    return false;
+                }
+                s->bytes += test.size();
+                s->tests.emplace(id, std::move(test));
+            }
+            ++s->read;
+            s->cond.notify_all();
+            return true;
+        };
+
+        // tests are split as in the file, bytes of each one are kept as they are
+        while (!eof) {
+            std::getline(*s->in, line);
+            eof = !s->in->good();
+            data += line;
+            if (!eof) {
+                data += '\n'; // the one which stopped getline
+            }
+
+            // separator can only be finished by a line which begins by '\r' or has "\r\r"
+            if (!eof && !line.empty() && line[0] != '\r' && line.find("\r\r") == std::string::npos) {
+                continue;
+            }
+
+            while (true) {
+                size_t pos = 0;
+                std::string_view test = tests_file::nextTest(data, pos);
+
+                // test without separator after it may go on, unless the stream is over
+                if (!eof && !test.empty() && test.data() + test.size() == data.data() + data.size()) {
+                    break;
+                }
+                if (!test.empty() && !push(std::string(test))) {
+                    return;
+                }
+                data.erase(0, pos);
+                if (test.empty()) {
+                    break;
+                }
+            }
+        }
+
+        std::lock_guard lck(s->mutex);
+        s->ended = true;
+        s->cond.notify_all();
+    }).detach();
+}
+
+bool test_stream::take(uint32_t id, std::string &test) {
+    std::unique_lock lck(s->mutex);
+
+    // there is no test if it was read already, but is not buffered
+    while (!s->tests.count(id) && id >= s->read && !s->ended) {
+        if (terminal::interrupted()) {
+            return false;
+        }
+        s->cond.wait_for(lck, POLL_INTERVAL);
+    }
+
+    auto it = s->tests.find(id);
+    if (it == s->tests.end()) {
+        return false;
+    }
+    s->bytes -= it->second.size();
+    test = std::move(it->second);
+    s->tests.erase(it);
+    s->cond.notify_all();
+    return true;
+}
+
+test_stream::~test_stream() {
+    std::lock_guard lck(s->mutex);
+    s->stopped = true;
+    s->cond.notify_all();
+}
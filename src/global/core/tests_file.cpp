@@ -0,0 +1,87 @@
+#include "core/tests_file.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    bool isLineBreak(char c) {
+        return c == '\r' || c == '\n';
+    }
+
+    // first '\r' or '\n' in [p, end)
+    char const *findLineBreak(char const *p, char const *end) {
+#if defined(__SSE2__)
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+
+        for (; end - p >= 16; p += 16) {
+            __m128i chunk = _mm_loadu_si128((__m128i const *) p);
+            int mask = _mm_movemask_epi8(_mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+            if (mask != 0) {
+                return p + __builtin_ctz(mask);
+            }
+        }
+#endif
+        while (p != end && !isLineBreak(*p)) {
+            ++p;
+        }
+        return p;
+    }
+}
+
+namespace tests_file {
+
+    std::string_view nextTest(std::string_view data, size_t &pos) {
+        char const *const first = data.data();
+        char const *const last = first + data.size();
+        char const *p = first + pos;
+
+        // trim
+        while (p != last && isLineBreak(*p)) {
+            ++p;
+        }
+        char const *begin = p;
+        char const *end = last;
+
+        while ((p = findLineBreak(p, last)) != last) {
+            size_t delimiters = 0;
+            char const *skipped = nullptr; // the second break, if it is '\r'
+            bool separator = false;
+
+            for (; p != last && isLineBreak(*p); ++p) {
+                if (*p == '\r') {
+                    ++delimiters;
+                    if (p[-1] == '\r') {
+                        separator = true;
+                        break;
+                    }
+                    if (delimiters == 2) {
+                        skipped = p;
+                    }
+                } else {
+                    // \r\n is a single line break
+                    if (p[-1] != '\r') {
+                        ++delimiters;
+                    }
+                    if (delimiters == 2) {
+                        separator = true;
+                        break;
+                    }
+                }
+            }
+
+            if (separator) {
+                end = skipped ? skipped : p;
+                ++p;
+                break;
+            } else if (p == last && skipped) {
+                end = skipped;
+            }
+        }
+
+        pos = (size_t) (p - first);
+        return {begin, (size_t) (end - begin)};
+    }
+}
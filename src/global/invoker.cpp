@@ -5,6 +5,7 @@
 #undef INVOKER_MACROS
 
 #include "core/runtime_config.h"
+#include <mutex>
 
 namespace {
     constexpr uint32_t MAX_SUBSTITUTION_NESTING = 5;
@@ -95,6 +96,9 @@ namespace invoker {
     exec_commands executionCommands;
     comp_commands compilationCommands;
 
+    // execution commands are compiled by workers on the first run
+    std::mutex executionCommandsMutex;
+
     template <typename T>
     auto compileExpr(runtime_config const &cfg, units::unit const &u, T t) {
         auto visitor = [&cfg, &u](auto &arg) {
@@ -138,32 +142,37 @@ namespace invoker {
 
     command const &getExecutionCommand(
             runtime_config const &cfg, units::unit const &u) {
-        if (!executionCommands.count(u.cat)) {
+        std::lock_guard lck(executionCommandsMutex);
+        const std::string key = u.file.string();
+
+        if (!executionCommands.count(key)) {
             const std::string &ext =
                     u.file.extension().string();
 
-            executionCommands[u.cat] =
+            executionCommands[key] =
                     executionRules.count(ext) ?
                     compileExpr(cfg, u, executionRules.at(ext)) : command();
         }
-        return executionCommands[u.cat];
+        return executionCommands[key];
     }
 
     comp_variant getCompilationCommand(
             runtime_config const &cfg, units::unit const &u) {
-        if (compilationCommands.count(u.cat)) {
-            return compilationCommands.at(u.cat);
+        const std::string key = u.file.string();
+
+        if (compilationCommands.count(key)) {
+            return compilationCommands.at(key);
         } else {
             const std::string &ext =
                     u.file.extension().string();
 
             if (!compilationRules.count(ext)) {
-                return compilationCommands[u.cat] = {};
+                return compilationCommands[key] = {};
             }
 
-            return std::visit([&cfg, &u](auto &arg) -> comp_variant {
+            return std::visit([&cfg, &u, &key](auto &arg) -> comp_variant {
                 if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, comp_rule>) {
-                    return compilationCommands[u.cat] = comp_rule(
+                    return compilationCommands[key] = comp_rule(
                             compileExpr(cfg, u, arg.first),
                             compileExpr(cfg, u, arg.second));
                 } else {
@@ -2,6 +2,7 @@
 #include "core/run.h"
 #include <filesystem>
 #include <iomanip>
+#include <algorithm>
 
 // logger implementation
 
@@ -50,6 +51,21 @@ logger::logger(runtime_config & cfg) {
 }
 
 logger::STATUS logger::writeTest(const runtime_config &cfg, const test_result &result, uint32_t testId, bool flush) {
+    bool seeded = isSeeded(cfg.testsSource) || cfg.testsSource == tests_source::PACK;
+    return write(cfg, result, "TEST " + std::to_string(testId), seeded, flush);
+}
+
+logger::STATUS logger::writeShrunkTest(const runtime_config &cfg, const test_result &result, uint32_t testId) {
+    return write(cfg, result, "TEST " + std::to_string(testId) + " SHRUNK", false, true);
+}
+
+logger::STATUS logger::writeWorstTest(const runtime_config &cfg, const test_result &result, uint32_t testId) {
+    bool seeded = isSeeded(cfg.testsSource) || cfg.testsSource == tests_source::PACK;
+    return write(cfg, result, "TEST " + std::to_string(testId) + " WORST", seeded, true);
+}
+
+logger::STATUS logger::write(const runtime_config &cfg, const test_result &result,
+                             std::string const &title, bool seeded, bool flush) {
     if (path.empty()) {
         return STATUS::NOT_NEEDED;
 
@@ -62,15 +78,28 @@ logger::STATUS logger::writeTest(const runtime_config &cfg, const test_result &r
             bad = true;
             return STATUS::OPEN_ERROR;
         }
+        if (isSeeded(cfg.testsSource)) {
+            // to replay tests by their numbers
+            logFile << "initial seed: " << cfg.initialSeed << std::endl << std::endl;
+        }
     }
 
     std::stringstream stream; // todo: newlines?
 
-    stream << "------- TEST " << testId << " -------" << std::endl;
+    stream << "------- " << title << " -------" << std::endl;
+    if (seeded) {
+        stream << "seed: " << result.seed << std::endl;
+    }
     stream << "verdict: " << result.verdict.toShortString();
     stream << ", " << result.execResult.time << " ms, ";
     stream << std::setprecision(1) << std::fixed;
-    stream << (result.execResult.memory/1014.l/1024) << " MB" << std::endl;
+    stream << (result.execResult.memory/1014.l/1024) << " MB";
+    if (result.timeLimit) {
+        stream << std::setprecision(2) << ", "
+               << (double) result.solutionTime / (double) std::max<size_t>(result.primeTime, 1)
+               << "x of prime, TL " << result.timeLimit << " ms";
+    }
+    stream << std::endl;
 
     if (result.execResult.error.hasError()) {
         stream << result.execResult.error.errorExplanation() << std::endl;
@@ -124,3 +153,29 @@ std::string logger::info() {
         return "[*] Nothing was logged";
     }
 }
+
+void logger::resume(std::filesystem::path const &previous, uint64_t size) {
+    std::error_code errCode;
+
+    if (path.empty() || previous.empty() || !exists(previous, errCode)) {
+        return;
+    }
+
+    // drop tests which were logged after the checkpoint
+    resize_file(previous, size, errCode);
+    path = previous;
+    logFile.open(path, std::ios::binary | std::ios::app);
+    logFile.seekp(0, std::ios::end);
+
+    if (errCode || logFile.fail()) {
+        bad = true;
+    }
+}
+
+std::pair<std::filesystem::path, uint64_t> logger::position() {
+    if (!logFile.is_open() || bad) {
+        return {};
+    }
+    logFile.flush();
+    return {path, (uint64_t) logFile.tellp()};
+}
@@ -1,6 +1,11 @@
 #include "parsing/args.h"
 #include "terminal.h"
+#include "core/complexity.h"
 #include <cstring>
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
+#include <thread>
 
 runtime_config args::parseArgs(int argc, char *argv[]) {
     namespace fs = std::filesystem;
@@ -61,6 +66,110 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
         }
     };
 
+    // number with optional K, M, G suffix, megabytes by default
+    auto parseSize = [&](int i, uint64_t &result) {
+        if (i == argc - 1) {
+            throw std::runtime_error("[!] Expected a size");
+        }
+        unsigned long long value;
+        char suffix = 'M';
+        char rest;
+
+        // nothing is allowed after the suffix
+        int scanned = sscanf(argv[i + 1], "%llu%c%c", &value, &suffix, &rest);
+        if (scanned < 1 || scanned > 2 || !strchr("KkMmGg", suffix)) {
+            throw std::runtime_error("[!] Expected a size like 512M or 32G");
+        }
+        int shift = strchr("Kk", suffix) ? 10 : strchr("Mm", suffix) ? 20 : 30;
+        result = (uint64_t) value << shift;
+    };
+
+    auto parseReplay = [&](int i, std::vector<replay_entry> &result) {
+        if (i == argc - 1) {
+            throw std::runtime_error("[!] Expected a list of tests");
+        }
+        std::stringstream stream(argv[i + 1]);
+        std::string token;
+        bool seeds = false;
+
+        while (std::getline(stream, token, ',')) {
+            replay_entry entry;
+            bool seed = !token.empty() && token[0] == 's';
+            try {
+                size_t pos;
+                auto value = std::stoul(token.substr(seed), &pos);
+                if (pos + seed != token.size() || value > UINT32_MAX || (!seed && value == 0)) {
+                    throw std::exception();
+                }
+                if (seed) {
+                    entry.id = (uint32_t) result.size();
+                    entry.seed = (uint32_t) value;
+                } else {
+                    entry.id = (uint32_t) value - 1;
+                }
+            } catch (...) {
+                throw std::runtime_error("[!] Expected a list of test numbers or seeds");
+            }
+            if (!result.empty() && seeds != seed) {
+                throw std::runtime_error("[!] Test numbers and seeds cannot be replayed together");
+            }
+            seeds = seed;
+            result.push_back(entry);
+        }
+        if (result.empty()) {
+            throw std::runtime_error("[!] Expected a list of tests");
+        }
+        if (!seeds) {
+            // tests are taken by index in ascending order
+            std::sort(result.begin(), result.end(), [](auto const &a, auto const &b) {
+                return a.id < b.id;
+            });
+            result.erase(std::unique(result.begin(), result.end(), [](auto const &a, auto const &b) {
+                return a.id == b.id;
+            }), result.end());
+        }
+    };
+
+    auto parseShard = [&](int i) {
+        if (i == argc - 1) {
+            throw std::runtime_error("[!] Expected a shard (i/N)");
+        }
+        unsigned index = 0, count = 0;
+        char tail;
+        if (sscanf(argv[i + 1], "%u/%u%c", &index, &count, &tail) != 2
+            || index < 1 || index > count) {
+            throw std::runtime_error("[!] Expected a shard (i/N), where 1 <= i <= N");
+        }
+        cfg.shardIndex = index - 1;
+        cfg.shardsCount = count;
+    };
+
+    auto parseScale = [&](int i) {
+        if (i == argc - 1) {
+            throw std::runtime_error("[!] Expected sizes (lo-hi)");
+        }
+        unsigned long long lo = 0, hi = 0;
+        char tail;
+        if (sscanf(argv[i + 1], "%llu-%llu%c", &lo, &hi, &tail) != 2 || lo < 1 || hi < lo) {
+            throw std::runtime_error("[!] Expected sizes (lo-hi), where 1 <= lo <= hi");
+        }
+        cfg.sizes = complexity::sizes(lo, hi);
+    };
+
+    // ratio with optional x suffix
+    auto parseRatio = [&](int i, double &result) {
+        if (i == argc - 1) {
+            throw std::runtime_error("[!] Expected a ratio (e.g. 3x)");
+        }
+        char suffix = 'x';
+        char rest;
+        // nothing is allowed after the suffix
+        int scanned = sscanf(argv[i + 1], "%lf%c%c", &result, &suffix, &rest);
+        if (scanned < 1 || scanned > 2 || suffix != 'x' || !(result > 0)) {
+            throw std::runtime_error("[!] Expected a positive ratio (e.g. 3x)");
+        }
+    };
+
     // parse arguments
     for (int i = 1; i < argc; ++i) {
         // limits
@@ -70,6 +179,12 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
         } else if (!strcmp(argv[i], "-ml")) {
             parseUnsigned(i++, cfg.memoryLimit);
 
+        } else if (!strcmp(argv[i], "-tl-rel")) {
+            parseRatio(i++, cfg.relativeTimeLimit);
+
+        } else if (!strcmp(argv[i], "-tl-floor")) {
+            parseUnsigned(i++, cfg.timeLimitFloor);
+
         } else if (!strcmp(argv[i], "-ptl")) {
             parseUnsigned(i++, cfg.primeTimeLimit);
 
@@ -99,7 +214,12 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
                 default:
                     throw std::runtime_error("[!] Use only one source of tests");
             }
-            parsePath(i++, cfg.generator.file);
+            // stdin is not a file, but tests can be streamed from it
+            if (i + 1 < argc && !strcmp(argv[i + 1], "-")) {
+                cfg.generator.file = argv[++i];
+            } else {
+                parsePath(i++, cfg.generator.file);
+            }
             cfg.testsSource = tests_source::FILE;
 
         } else if (!strcmp(argv[i], "-d")) {
@@ -114,8 +234,91 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
             parsePath(i++, cfg.generator.file);
             cfg.testsSource = tests_source::DIR;
 
+        } else if (!strcmp(argv[i], "-pack")) {
+            switch (cfg.testsSource) {
+                case tests_source::PACK:
+                    [[fallthrough]];
+                case tests_source::UNSPECIFIED:
+                    break;
+                default:
+                    throw std::runtime_error("[!] Use only one source of tests");
+            }
+            parsePath(i++, cfg.generator.file);
+            cfg.testsSource = tests_source::PACK;
+
+        } else if (!strcmp(argv[i], "-plugin")) {
+            switch (cfg.testsSource) {
+                case tests_source::PLUGIN:
+                    [[fallthrough]];
+                case tests_source::UNSPECIFIED:
+                    break;
+                default:
+                    throw std::runtime_error("[!] Use only one source of tests");
+            }
+            parsePath(i++, cfg.generator.file);
+            cfg.testsSource = tests_source::PLUGIN;
+
+        } else if (!strcmp(argv[i], "-spec")) {
+            switch (cfg.testsSource) {
+                case tests_source::SPEC:
+                    [[fallthrough]];
+                case tests_source::UNSPECIFIED:
+                    break;
+                default:
+                    throw std::runtime_error("[!] Use only one source of tests");
+            }
+            parsePath(i++, cfg.generator.file);
+            cfg.testsSource = tests_source::SPEC;
+
+        } else if (!strcmp(argv[i], "-mutate")) {
+            switch (cfg.testsSource) {
+                case tests_source::MUTATE:
+                    [[fallthrough]];
+                case tests_source::UNSPECIFIED:
+                    break;
+                default:
+                    throw std::runtime_error("[!] Use only one source of tests");
+            }
+            parsePath(i++, cfg.generator.file);
+            cfg.testsSource = tests_source::MUTATE;
+
+        } else if (!strcmp(argv[i], "-scale")) {
+            parseScale(i++);
+
+        } else if (!strcmp(argv[i], "-worst")) {
+            if (i + 1 == argc) {
+                throw std::runtime_error("[!] Expected time or memory");
+            }
+            std::string kind = argv[++i];
+            if (kind == "time") {
+                cfg.worst = worst_case::TIME;
+            } else if (kind == "memory") {
+                cfg.worst = worst_case::MEMORY;
+            } else {
+                throw std::runtime_error("[!] Expected time or memory");
+            }
+
+        } else if (!strcmp(argv[i], "-validator")) {
+            parsePath(i++, cfg.validator.file);
+
+        } else if (!strcmp(argv[i], "-batch")) {
+            parseUnsigned(i++, cfg.batchSize);
+            if (cfg.batchSize < 1) {
+                throw std::runtime_error(
+                        "[!] Size of batch must be a positive number");
+            }
+
+        } else if (!strcmp(argv[i], "-record")) {
+            if (i + 1 == argc) {
+                throw std::runtime_error("[!] Expected a path");
+            }
+            cfg.recordPath = argv[++i];
+
         } else if (!strcmp(argv[i], "-s")) {
             parseUnsigned(i++, cfg.initialSeed);
+
+        } else if (!strcmp(argv[i], "-replay")) {
+            parseReplay(i++, cfg.replay);
         }
 
         // invoker_config
@@ -129,11 +332,66 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
                         "[!] Count of workers must be a positive number");
             }
 
+        } else if (!strcmp(argv[i], "-mem-budget")) {
+            parseSize(i++, cfg.memoryBudget);
+
         } else if (!strcmp(argv[i], "-c")) {
             parseUnitCategory(i++, cfg.useCached);
 
+        } else if (!strcmp(argv[i], "-shard")) {
+            parseShard(i++);
+
+        } else if (!strcmp(argv[i], "-serve")) {
+            if (i + 1 == argc) {
+                throw std::runtime_error("[!] Expected an address");
+            }
+            cfg.serveAddress = argv[++i];
+
+        } else if (!strcmp(argv[i], "-join")) {
+            if (i + 1 == argc) {
+                throw std::runtime_error("[!] Expected an address");
+            }
+            cfg.joinAddress = argv[++i];
+
         } else if (!strcmp(argv[i], "-mt")) {
             cfg.multithreading = true;
+
+        } else if (!strcmp(argv[i], "-multitest")) {
+            parseUnsigned(i++, cfg.multitestSize);
+            if (cfg.multitestSize < 1) {
+                throw std::runtime_error(
+                        "[!] Count of tests in a group must be a positive number");
+            }
+
+        } else if (!strcmp(argv[i], "-multitest-no-count")) {
+            cfg.multitestCount = false;
+
+        } else if (!strcmp(argv[i], "-multitest-sep")) {
+            if (i + 1 == argc) {
+                throw std::runtime_error("[!] Expected a separator line");
+            }
+            cfg.multitestSeparator = argv[++i];
+
+        } else if (!strcmp(argv[i], "-resume")) {
+            cfg.resume = true;
+
+        } else if (!strcmp(argv[i], "-shrink")) {
+            cfg.shrink = true;
+
+        } else if (!strcmp(argv[i], "-bench")) {
+            parseUnsigned(i++, cfg.benchRuns);
+            if (cfg.benchRuns < 1) {
+                throw std::runtime_error(
+                        "[!] Count of runs must be a positive number");
+            }
+
+        } else if (!strcmp(argv[i], "-warmup")) {
+            parseUnsigned(i++, cfg.warmupRuns);
+
+        } else if (!strcmp(argv[i], "-pin")) {
+            uint32_t core;
+            parseUnsigned(i++, core);
+            cfg.pinnedCore = core;
         }
 
         // terminal_config
@@ -146,6 +404,19 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
         } else if (!strcmp(argv[i], "-st")) {
             cfg.displayStats = true;
 
+        } else if (!strcmp(argv[i], "-watch")) {
+            cfg.watch = true;
+
+        } else if (!strcmp(argv[i], "-dedup")) {
+            cfg.dedup = true;
+
+        } else if (!strcmp(argv[i], "-corpus")) {
+            if (i + 1 == argc) {
+                throw std::runtime_error("[!] Expected a path");
+            }
+            cfg.corpusPath = argv[++i];
+            cfg.dedup = true;
+
         } else if (!strcmp(argv[i], "-dnl")) {
             cfg.doNotLog = true;
         }
@@ -170,9 +441,16 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
         }
 
         // runtime_config
-        else if (!strcmp(argv[i], "-pre")) {
+        else if (!strcmp(argv[i], "-vs")) {
+            cfg.variants.emplace_back(cat::TO_TEST);
+            parsePath(i++, cfg.variants.back().file);
+
+        } else if (!strcmp(argv[i], "-pre")) {
             cfg.ignorePRE = true;
 
+        } else if (!strcmp(argv[i], "-pcache")) {
+            cfg.primeCache = true;
+
         } else if (argv[i][0] == '-') {
             throw std::runtime_error(
                     "[!] Unknown option: " + std::string(argv[i]));
@@ -201,6 +479,117 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
     } else if (!cfg.prime.empty() && !cfg.verifier.empty()) {
         throw std::runtime_error(
                 "[!] Prime solution and verifier can only be set separately");
+    } else if (!cfg.replay.empty() && cfg.replay[0].seed
+               && !isSeeded(cfg.testsSource)) {
+        throw std::runtime_error(
+                "[!] Tests can be replayed by seeds only with generator");
+
+    } else if (!cfg.serveAddress.empty() && !cfg.joinAddress.empty()) {
+        throw std::runtime_error(
+                "[!] Coordinator and worker cannot be started together");
+
+    } else if (cfg.resume && !cfg.joinAddress.empty()) {
+        throw std::runtime_error(
+                "[!] Session can only be resumed by coordinator");
+
+    } else if (cfg.multitestSize == 1 && (!cfg.multitestCount || cfg.multitestSeparator)) {
+        throw std::runtime_error(
+                "[!] Format of groups can be set only if tests are grouped");
+
+    } else if (cfg.multitestSize > 1 && (!cfg.serveAddress.empty() || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Tests can't be grouped in cluster");
+
+    } else if (cfg.shrink && (cfg.multitestSize > 1 || !cfg.serveAddress.empty() || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Tests can't be shrunk if grouped or run in cluster");
+
+    } else if (cfg.worst != worst_case::NONE
+               && (cfg.multitestSize > 1 || !cfg.serveAddress.empty() || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Worst case can't be searched if tests are grouped or run in cluster");
+
+    } else if (!cfg.sizes.empty() && cfg.testsSource != tests_source::EXECUTABLE) {
+        throw std::runtime_error(
+                "[!] Only generator can make tests of given sizes");
+
+    } else if (!cfg.sizes.empty()
+               && (cfg.batchSize > 1 || cfg.multitestSize > 1 || !cfg.serveAddress.empty()
+                   || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Complexity can't be estimated if tests are batched, grouped or run in cluster");
+
+    } else if (cfg.benchRuns && (cfg.multitestSize > 1 || !cfg.serveAddress.empty() || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Tests can't be benchmarked if grouped or run in cluster");
+
+    } else if (cfg.pinnedCore && !cfg.benchRuns) {
+        throw std::runtime_error(
+                "[!] Solution can be pinned to a core only to benchmark it");
+
+    } else if (cfg.pinnedCore && cfg.multithreading) {
+        throw std::runtime_error(
+                "[!] Solution can't be pinned to a core if tests are run by many workers");
+
+    } else if (cfg.pinnedCore && *cfg.pinnedCore >= std::max(1u, std::thread::hardware_concurrency())) {
+        throw std::runtime_error(
+                "[!] There is no core " + std::to_string(*cfg.pinnedCore));
+
+    } else if (!cfg.variants.empty() && cfg.prime.empty() && cfg.verifier.empty()) {
+        throw std::runtime_error(
+                "[!] Variants of solution can be compared only if checked by prime or verifier");
+
+    } else if (!cfg.variants.empty()
+               && (cfg.multitestSize > 1 || !cfg.serveAddress.empty() || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Variants of solution can't be compared if tests are grouped or run in cluster");
+
+    } else if (cfg.relativeTimeLimit > 0 && cfg.prime.empty()) {
+        throw std::runtime_error(
+                "[!] Time limit can be relative only to prime solution");
+
+    } else if (cfg.relativeTimeLimit > 0 && cfg.multitestSize > 1) {
+        throw std::runtime_error(
+                "[!] Time limit can't be relative to prime if tests are grouped");
+
+    } else if (!cfg.validator.empty() && cfg.testsSource != tests_source::MUTATE) {
+        throw std::runtime_error(
+                "[!] Only tests made by mutations can be validated");
+
+    } else if (cfg.watch && cfg.testsSource != tests_source::DIR) {
+        throw std::runtime_error(
+                "[!] Only directory of tests can be watched");
+
+    } else if (cfg.testsSource == tests_source::FILE && cfg.generator.file == "-"
+               && (cfg.pausing || !cfg.replay.empty() || cfg.resume || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Tests from stdin are read once, so they can't be paused on, replayed or resumed");
+
+    } else if (cfg.primeCache && cfg.prime.empty()) {
+        throw std::runtime_error(
+                "[!] Outputs can be cached only for prime solution");
+
+    } else if (cfg.batchSize > 1 && cfg.testsSource != tests_source::EXECUTABLE) {
+        throw std::runtime_error(
+                "[!] Tests can be made by batches only with generator");
+
+    } else if (cfg.batchSize > 1 && !cfg.joinAddress.empty()) {
+        throw std::runtime_error(
+                "[!] Tests can't be made by batches on cluster workers");
+
+    } else if (!cfg.recordPath.empty() && !isSeeded(cfg.testsSource)) {
+        throw std::runtime_error(
+                "[!] Only tests of generator can be recorded");
+
+    } else if (!cfg.recordPath.empty()
+               && (cfg.resume || !cfg.serveAddress.empty() || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Tests can't be recorded in resumed session or cluster");
+
+    } else if (cfg.dedup && (!cfg.serveAddress.empty() || !cfg.joinAddress.empty())) {
+        throw std::runtime_error(
+                "[!] Duplicate tests can't be skipped in cluster");
+
     } else if ((cfg.pausing || cfg.collapseVerdicts) && terminal::isStdoutRedirected()) {
         throw std::runtime_error(
                 "[!] Flags -p and -cv cannot be set if stdout redirected");
@@ -208,7 +597,8 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
 
     // constraints check
     if ((cfg.timeLimit > 0 && cfg.timeLimit < constraints::MIN_TIME_LIMIT_MS)
-    || (cfg.primeTimeLimit > 0 && cfg.primeTimeLimit < constraints::MIN_TIME_LIMIT_MS)) {
+    || (cfg.primeTimeLimit > 0 && cfg.primeTimeLimit < constraints::MIN_TIME_LIMIT_MS)
+    || cfg.timeLimitFloor < constraints::MIN_TIME_LIMIT_MS) {
         throw std::runtime_error(
                 "[!] Minimum time limit is " +
                 std::to_string(constraints::MIN_TIME_LIMIT_MS) + " ms");
@@ -221,19 +611,33 @@ runtime_config args::parseArgs(int argc, char *argv[]) {
     }
 
     // implicit configuring
+    if (!cfg.sizes.empty()) { // -n tests of each size
+        cfg.sizeRepeats = cfg.testsCount;
+        cfg.testsCount *= (uint32_t) cfg.sizes.size();
+    }
     if (cfg.timeLimit > 0) {
         cfg.toTest.timeLimit = cfg.timeLimit;
         cfg.displayStats = true;
     }
+    if (cfg.relativeTimeLimit > 0) {
+        cfg.displayStats = true;
+    }
     if (cfg.memoryLimit > 0) { // convert from MB to bytes
-        cfg.toTest.memoryLimit = cfg.memoryLimit * 1024 * 1024;
+        cfg.toTest.memoryLimit = (size_t) cfg.memoryLimit * 1024 * 1024;
         cfg.displayStats = true;
     }
+    for (auto &v: cfg.variants) { // limits are the same as of solution
+        v.timeLimit = cfg.toTest.timeLimit;
+        v.memoryLimit = cfg.toTest.memoryLimit;
+    }
     if (cfg.primeTimeLimit > 0) {
         cfg.prime.timeLimit = cfg.primeTimeLimit;
     }
-    if (cfg.memoryLimit > 0) {
-        cfg.prime.memoryLimit = cfg.primeMemoryLimit * 1024 * 1024;
+    if (cfg.primeMemoryLimit > 0) {
+        cfg.prime.memoryLimit = (size_t) cfg.primeMemoryLimit * 1024 * 1024;
+    }
+    if (!cfg.replay.empty()) {
+        cfg.testsCount = (uint32_t) cfg.replay.size();
     }
     if (cfg.initialSeed == 0) {
         using namespace std::chrono;
@@ -3,11 +3,20 @@
 #include "logger.h"
 #include "terminal.h"
 #include "core/run.h"
+#include "core/session.h"
+#include "core/chain.h"
+#include "core/memory_budget.h"
+#include "core/cluster.h"
+#include "core/multitest.h"
+#include "core/shrinker.h"
+#include "core/complexity.h"
 #include "units/to_test.h"
 #include "units/prime.h"
 #include "units/verifier.h"
+#include "units/validator.h"
 #include "invoker.h"
 #include <sstream>
+#include <algorithm>
 #include <vector>
 #include <filesystem>
 #include <optional>
@@ -15,11 +24,22 @@
 
 namespace fs = std::filesystem;
 
-void dispatcher(runtime_config &, logger &);
+void dispatcher(runtime_config &, logger &, std::optional<checkpoint> const &);
 
 void build_units(runtime_config &);
 
-void worker(runtime_config &, session &);
+void worker(runtime_config &, session &, memory_budget &);
+
+void shrink(runtime_config &, logger &, memory_budget &, uint32_t workersCount, test_result &);
+
+void reportWorst(runtime_config const &, logger &, worst_case, std::vector<test_result> const &);
+
+uint32_t workers_count(runtime_config const &);
+
+namespace {
+    // remote workers are unknown in advance
+    constexpr uint32_t REMOTE_WORKERS_HINT = 64;
+}
 
 void stress::start(int argc, char *argv[]) {
     runtime_config cfg = args::parseArgs(argc, argv);
@@ -27,9 +47,22 @@ void stress::start(int argc, char *argv[]) {
     // ctor throws exception
     logger l(cfg);
 
+    // fail early if there is nothing to resume
+    std::optional<checkpoint> resumed;
+    if (cfg.resume) {
+        resumed = checkpoint::load(cfg);
+        cfg.initialSeed = resumed->initialSeed;
+    }
+
     // if succeeded, clear screen
     terminal::clear();
 
+    // coordinator doesn't run anything itself
+    if (!cfg.serveAddress.empty()) {
+        dispatcher(cfg, l, resumed);
+        return;
+    }
+
     // initialize invoker
     invoker::initializer();
 
@@ -53,7 +86,22 @@ void stress::start(int argc, char *argv[]) {
         }
     }
 
-    dispatcher(cfg, l);
+    for (auto &unit: cfg.variantUnits) {
+        if (!unit->prepare(cfg)) {
+            if (!terminal::interrupted()) {
+                throw std::runtime_error("[!] Unable to prepare variant " + unit->file.string());
+            } else {
+                terminal::syncOutput("Stress-testing interrupted\n");
+                return;
+            }
+        }
+    }
+
+    if (!cfg.joinAddress.empty()) {
+        cluster::join(cfg, workers_count(cfg));
+    } else {
+        dispatcher(cfg, l, resumed);
+    }
 }
 
 void stress::usage() {
@@ -63,24 +111,53 @@ void stress::usage() {
     const static std::pair<std::string, std::string> OPTIONS[] = {
             {"General:",   ""},
             {"-p",         "Pause each time test fails"},
+            {"-shrink",    "Minimize the first failed test"},
             {"-c [gvtp]",  "Do not recompile files if compiled ones cached"},
-            {"-n n",       "Run n tests (default: 10)\n"},
+            {"-n n",       "Run n tests (default: 10)"},
+            {"-shard i/N", "Run only i-th of N disjoint parts of tests\n"},
             {"Tests:",     ""},
             {"-g file",    "Path to test generator"},
-            {"-f file",    "Path to file with tests"},
+            {"-f file",    "Path to file with tests (- is stdin)"},
             {"-d dir",     "Path to directory with tests"},
-            {"-s seed",    "Start generator with a specific seed\n"},
+            {"-watch",     "Wait for new tests in directory"},
+            {"-plugin file", "Path to generator built as a shared library"},
+            {"-spec file", "Path to description of tests made by stress itself"},
+            {"-mutate path", "Make tests by changes of tests in file, log or dir"},
+            {"-validator", "Path to validator of tests made by changes"},
+            {"-s seed",    "Start generator with a specific seed"},
+            {"-batch k",   "Make k tests by a single run of generator"},
+            {"-pack file", "Path to pack of recorded tests"},
+            {"-record file", "Record generated tests to a pack"},
+            {"-replay list", "Run only tests with given numbers or seeds (s-prefixed)"},
+            {"-dedup",     "Skip tests with inputs seen before"},
+            {"-corpus file", "Skip tests seen by previous runs and store new ones"},
+            {"-worst kind", "Search for tests with most time or memory of solution"},
+            {"-scale lo-hi", "Pass sizes to generator and estimate complexity\n"},
             {"Limits:",    ""},
             {"-st",        "Display time and peak memory statistics"},
+            {"-bench k",   "Measure k runs of solution on each accepted test"},
+            {"-warmup w",  "Runs of solution before measured ones (default: 1)"},
+            {"-pin core",  "Run solution only on the given core while benchmarking"},
             {"-tl ms",     "Set time limit in milliseconds"},
-            {"-ml mb",     "Set memory limit in MB\n"},
+            {"-ml mb",     "Set memory limit in MB"},
+            {"-tl-rel k",  "Set time limit to k times the time of prime on each test"},
+            {"-tl-floor ms", "Set the least relative time limit (default: 100)\n"},
             {"Prime:",     ""},
             {"-ptl ms",    "Set time limit for prime"},
             {"-pml mb",    "Set memory limit for prime"},
-            {"-pre",       "Do not stop if prime got RE\n"},
+            {"-pre",       "Do not stop if prime got RE"},
+            {"-pcache",    "Reuse outputs of prime cached by previous runs\n"},
             {"Threading:", ""},
             {"-mt",        "Allow multithreaded testing"},
-            {"-w n",       "Set count of workers\n"},
+            {"-w n",       "Set count of workers"},
+            {"-mem-budget", "Limit total memory of programs run at once (e.g. 32G)"},
+            {"-multitest k", "Run k tests at once as a single input with count of them"},
+            {"-multitest-no-count", "Do not put count of tests before the group"},
+            {"-multitest-sep line", "Split outputs of the group into tests by the line"},
+            {"-resume",    "Continue interrupted session from its checkpoint\n"},
+            {"Cluster:",   ""},
+            {"-serve addr", "Hand tests out to workers (host:port or unix:path)"},
+            {"-join addr", "Run tests given by coordinator\n"},
             {"Logging:",   ""},
             {"-stderr",    "Log stderr on runtime errors (useful with Java, Python, etc.)"},
             {"-tag",       "Set tag of log file"},
@@ -88,6 +165,8 @@ void stress::usage() {
             {"Verifier:",  ""},
             {"-v file",    "Path to custom verifier"},
             {"-vstrict",   "Use strict comparison of outputs\n"},
+            {"Variants:",  ""},
+            {"-vs file",   "Also run a variant of solution, compare time of them\n"},
             {"Misc:",      ""},
             {"-cv",        "Collapse identical verdicts\n"}
     };
@@ -132,24 +211,58 @@ void build_units(runtime_config &cfg) {
             std::dynamic_pointer_cast<units::unit>(
                     std::make_shared<units::verifier>(
                             cfg.verifier)));
+    cfg.units.emplace(
+            units::unit_category::VALIDATOR,
+            std::dynamic_pointer_cast<units::unit>(
+                    std::make_shared<units::validator>(
+                            cfg.validator)));
+    for (auto const &v: cfg.variants) {
+        cfg.variantUnits.emplace_back(
+                std::dynamic_pointer_cast<units::unit>(
+                        std::make_shared<units::to_test>(v)));
+    }
 }
 
-void dispatcher(runtime_config &cfg, logger &logger) {
+uint32_t workers_count(runtime_config const &cfg) {
     const auto hc = std::thread::hardware_concurrency();
 
     // keep one thread for stress process
     const auto idealThreadsCount = std::max(2u, hc ? hc - 1 : hc);
 
-    // workers count shouldn't be more than tasks count
-    const auto workersCount =
-            std::min(cfg.testsCount,
-                     cfg.multithreading ?
-                     (cfg.workersCount ? cfg.workersCount : idealThreadsCount) : 1);
+    if (!cfg.multithreading) {
+        return 1;
+    } else if (cfg.workersCount) {
+        return cfg.workersCount;
+    }
+
+    // do not start workers which would wait for memory anyway
+    const uint64_t perTest = memory_budget::testEstimate(cfg);
+
+    if (cfg.memoryBudget && perTest) {
+        return (uint32_t) std::clamp<uint64_t>(cfg.memoryBudget / perTest, 1, idealThreadsCount);
+    }
+    return idealThreadsCount;
+}
+
+void dispatcher(runtime_config &cfg, logger &logger, std::optional<checkpoint> const &resumed) {
+    const bool coordinator = !cfg.serveAddress.empty();
+
+    // workers count shouldn't be more than tasks count of the shard
+    const auto workersCount = coordinator ? 0 : std::min(session::shardTestsCount(cfg), workers_count(cfg));
 
     std::vector<std::thread> workers(workersCount);
-    session session(cfg, logger);
+    memory_budget budget(cfg);
+    session session(cfg, logger, coordinator ?
+                                 (cfg.workersCount ? cfg.workersCount : REMOTE_WORKERS_HINT) :
+                                 workersCount);
+
+    if (resumed) {
+        logger.resume(resumed->logPath, resumed->logSize);
+        session.restore(*resumed);
+        terminal::syncOutput("[*] Resumed after ", resumed->testsCompleted, " tests\n");
+    }
 
-    if (cfg.multithreading) {
+    if (cfg.multithreading && !coordinator) {
         terminal::syncOutput("[*] Workers count: ", workersCount, '\n');
     }
     terminal::syncOutput("[*] Ready\n\n");
@@ -158,23 +271,77 @@ void dispatcher(runtime_config &cfg, logger &logger) {
     auto start = steady_clock::now();
     uint64_t elapsed;
 
+    if (coordinator) {
+        cluster::serve(cfg, session);
+    }
+
     for (auto &i: workers) {
-        i = std::thread(worker, std::ref(cfg), std::ref(session));
+        if (cfg.multitestSize > 1) {
+            i = std::thread(multitest::worker, std::ref(cfg), std::ref(session), std::ref(budget));
+        } else {
+            i = std::thread(worker, std::ref(cfg), std::ref(session), std::ref(budget));
+        }
     }
 
     for (auto &i: workers) {
         i.join();
     }
 
+    if (session.firstFailure && !terminal::interrupted()) {
+        shrink(cfg, logger, budget, workersCount, *session.firstFailure);
+    }
+
+    // keep the progress if session was interrupted
+    session.finish();
+
     elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
 
     if (cfg.displayStats) {
         std::stringstream stream;
         stream << '\n';
-        stream << "Average time: " << (session.totalTime / session.testsDone) << " ms\n";
+        // the shard may have no tests
+        if (session.testsDone) {
+            stream << "Average time: " << (session.totalTime / session.testsDone) << " ms\n";
+        }
         stream << "Maximum time: " << session.maxTime << " ms\n";
         stream << "Completed in: " << elapsed << " ms\n";
+
+        if (session.solutionTimes.count()) {
+            stream << histogram::report("Time of solution to test", session.solutionTimes, false);
+            stream << histogram::report("Memory of solution to test", session.solutionMemories, true);
+        }
+        if (session.primeTimes.count()) {
+            stream << histogram::report("Time of prime solution", session.primeTimes, false);
+            stream << histogram::report("Memory of prime solution", session.primeMemories, true);
+        }
         terminal::syncOutput(stream.str());
+
+        if (!session.slowestTests.empty()) {
+            reportWorst(cfg, logger, worst_case::TIME, session.slowestTests);
+        }
+        if (!session.hungriestTests.empty()) {
+            reportWorst(cfg, logger, worst_case::MEMORY, session.hungriestTests);
+        }
+    }
+
+    if (!session.benchmarks.empty()) {
+        terminal::syncOutput(benchmark::report(cfg, session.benchmarks));
+    }
+
+    if (!session.comparisons.empty()) {
+        terminal::syncOutput(ranking::report(cfg, session.comparisons));
+    }
+
+    if (!session.measurements.empty()) {
+        terminal::syncOutput(complexity::report(cfg, session.measurements));
+    }
+
+    if (!session.worstTests.empty()) {
+        reportWorst(cfg, logger, cfg.worst, session.worstTests);
+    }
+
+    if (session.duplicates) {
+        terminal::syncOutput('\n', "[*] Duplicates skipped: ", session.duplicates, '\n');
     }
 
     terminal::syncOutput('\n', "[*] Stress-testing is over. Solution is ");
@@ -183,57 +350,56 @@ void dispatcher(runtime_config &cfg, logger &logger) {
     terminal::flush();
 }
 
-void worker(runtime_config &cfg, session &session) {
-    using cat = units::unit_category;
-
+void worker(runtime_config &cfg, session &session, memory_budget &budget) {
     test_result result;
-    std::shared_ptr<units::generator> generator =
-            std::dynamic_pointer_cast<units::generator>(
-                    cfg.units[cat::GENERATOR]);
+    chain c(cfg, budget);
+
+    // run sequence n times in sum
+    while (session.newTest(result)) {
+        c.run(cfg, result);
 
-    // make run sequence
-    std::vector<std::shared_ptr<units::unit>> u;
-    u.emplace_back(cfg.units[cat::GENERATOR]);
-    u.emplace_back(cfg.units[cat::TO_TEST]);
+        // each test index must be reported, even if there are no more tests
+        session.processedTest(result);
 
-    if (!cfg.prime.empty()) {
-        u.emplace_back(cfg.units[cat::PRIME]);
+        // clear struct before next run
+        result.clear();
     }
+}
+
+void shrink(runtime_config &cfg, logger &logger, memory_budget &budget, uint32_t workersCount, test_result &failed) {
+    uint32_t testId = failed.id + 1;
+    size_t size = failed.input.size();
+    terminal::syncOutput('\n', "[*] Shrinking test ", testId, '\n');
 
-    if (!cfg.verifier.empty() || !cfg.prime.empty()) {
-        u.emplace_back(cfg.units[cat::VERIFIER]);
+    if (!shrinker::shrink(cfg, budget, workersCount, failed)) {
+        terminal::syncOutput("[*] Test ", testId, " can't be shrunk\n");
+        return;
     }
 
-    // run sequence n times in sum
-    while (session.newTest(result.seed)) {
-        for (auto &p: u) {
-            p->execute(cfg, result);
-
-            // if interrupted, there are no interesting errors
-            if (terminal::interrupted()) {
-                result.verdict = verdict::NOT_TESTED;
-                session.processedTest(result);
-                break;
-            }
+    terminal::syncOutput("[*] Test ", testId, " is shrunk from ", size, " to ", failed.input.size(), " bytes\n");
+    auto status = logger.writeShrunkTest(cfg, failed, testId);
+    if (status != logger::STATUS::OK && status != logger::STATUS::NOT_NEEDED) {
+        terminal::syncOutput(logger::statusExplanation(status), '\n');
+    }
+}
 
-            // if error happened
-            if (result.verdict.isOrdinaryError() || result.verdict.isCriticalError()) {
-                session.processedTest(result);
-                break;
-            }
+void reportWorst(runtime_config const &cfg, logger &logger, worst_case kind, std::vector<test_result> const &tests) {
+    bool seeded = isSeeded(cfg.testsSource) || cfg.testsSource == tests_source::PACK;
+    std::stringstream stream;
+    stream << '\n' << (kind == worst_case::TIME ? "[*] Slowest tests:" : "[*] Tests with most memory:") << '\n';
 
-            // no more tests
-            if (result.verdict == verdict::TESTS_OVER) {
-                break;
-            }
+    for (auto const &test: tests) {
+        stream << "Test " << test.id + 1 << ", " << test.solutionTime << " ms, "
+               << test.solutionMemory / 1024 / 1024 << " MB";
+        if (seeded) {
+            stream << ", seed " << test.seed;
         }
+        stream << '\n';
 
-        // if it's all OK
-        if (result.verdict == verdict::ACCEPTED) {
-            session.processedTest(result);
+        auto status = logger.writeWorstTest(cfg, test, test.id + 1);
+        if (status != logger::STATUS::OK && status != logger::STATUS::NOT_NEEDED) {
+            stream << logger::statusExplanation(status) << '\n';
         }
-
-        // clear struct before next run
-        result.clear();
     }
+    terminal::syncOutput(stream.str());
 }
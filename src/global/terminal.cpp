@@ -4,6 +4,7 @@
 #include <csignal>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
 
 namespace {
     constexpr char oops[] = "\nOops, unexpected termination.\nPlease, tell the developer how to reproduce this error.\n";
@@ -80,6 +81,12 @@ void terminal::writeTestResult(runtime_config const &cfg, test_result &result, u
         if (cfg.displayStats && statsAllowed) {
             str << std::setw(4) << std::right << result.execResult.time << " ms, ";
             str << (result.execResult.memory / 1024 / 1024) << " MB";
+
+            if (result.timeLimit) {
+                str << ", " << std::fixed << std::setprecision(2)
+                    << (double) result.solutionTime / (double) std::max<size_t>(result.primeTime, 1)
+                    << "x of prime, TL " << result.timeLimit << " ms";
+            }
         }
         collapsed = false;
     }
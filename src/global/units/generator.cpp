@@ -1,6 +1,139 @@
 #include "units/generator.h"
 #include "core/run.h"
+#include "core/runtime_config.h"
+#include "core/session.h"
+#include "core/compression.h"
+#include "core/complexity.h"
+#include "core/tests_file.h"
+#include "core/memory_budget.h"
 #include "invoker.h"
+#include "terminal.h"
+#include <fstream>
+#include <algorithm>
+
+namespace {
+    // tests of batch are separated by a line with this character
+    constexpr char BATCH_DELIMITER = '\x1e';
+
+    // batches are made ahead no more than workers can take
+    constexpr size_t MAX_GENERATED_TESTS = 1 << 16;
+
+    // changes of a test tried until validator accepts one
+    constexpr uint32_t MAX_MUTATION_ATTEMPTS = 16;
+
+    // how often watched directory is checked for interruption
+    constexpr uint32_t WATCH_INTERVAL_MS = 100;
+
+    // how much of directory is read ahead
+    constexpr size_t PREFETCH_FILES = 64;
+    constexpr size_t PREFETCH_BYTES = 64 * 1024 * 1024;
+
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    // numbers are compared by value, so "test2" goes before "test10"
+    int naturalCompare(std::string const &a, std::string const &b) {
+        size_t i = 0;
+        size_t j = 0;
+
+        while (i < a.size() && j < b.size()) {
+            if (isDigit(a[i]) && isDigit(b[j])) {
+                while (i < a.size() && a[i] == '0') ++i;
+                while (j < b.size() && b[j] == '0') ++j;
+
+                size_t aEnd = i;
+                size_t bEnd = j;
+                while (aEnd < a.size() && isDigit(a[aEnd])) ++aEnd;
+                while (bEnd < b.size() && isDigit(b[bEnd])) ++bEnd;
+
+                // longer number without leading zeros is greater
+                if (aEnd - i != bEnd - j) {
+                    return aEnd - i < bEnd - j ? -1 : 1;
+                }
+                if (int c = a.compare(i, aEnd - i, b, j, bEnd - j)) {
+                    return c;
+                }
+                i = aEnd;
+                j = bEnd;
+            } else if (a[i] != b[j]) {
+                return (unsigned char) a[i] < (unsigned char) b[j] ? -1 : 1;
+            } else {
+                ++i;
+                ++j;
+            }
+        }
+        return (i < a.size()) - (j < b.size());
+    }
+
+    // file is appended to the test
+    bool readFile(std::filesystem::path const &path, std::string &test) {
+        std::ifstream in(path, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+        if (!in.is_open() || in.bad()) {
+            return false;
+        }
+        std::ifstream::pos_type size = in.tellg();
+        size_t prefix = test.size();
+
+        // read straight into the test
+        test.resize(prefix + (size_t) size);
+        in.seekg(0, std::ios::beg);
+        in.read(test.data() + prefix, size);
+
+        return !in.bad();
+    }
+
+    bool naturalLess(std::string const &a, std::string const &b) {
+        int c = naturalCompare(a, b);
+        // "01" and "1" are equal numbers, but the order must be strict
+        return c != 0 ? c < 0 : a < b;
+    }
+
+    // inputs of the tests in a log file of stress
+    std::vector<std::string> loggedTests(std::string_view data) {
+        enum { OUTSIDE, HEADER, DUMP, INPUT } state = OUTSIDE;
+        std::vector<std::string> result;
+
+        // input is followed by empty lines
+        auto finish = [&] {
+            std::string &test = result.back();
+            while (!test.empty() && test.back() == '\n') {
+                test.pop_back();
+            }
+            if (test.empty()) {
+                result.pop_back();
+            } else {
+                test += '\n';
+            }
+        };
+
+        for (size_t pos = 0; pos < data.size();) {
+            size_t end = std::min(data.find('\n', pos), data.size());
+            std::string_view line = data.substr(pos, end - pos);
+            pos = end + 1;
+
+            if (line.rfind("------- TEST ", 0) == 0) {
+                if (state == INPUT) {
+                    finish();
+                }
+                state = HEADER;
+            } else if (state == HEADER && line == "stderr dump: >>>") {
+                state = DUMP;
+            } else if (state == DUMP && line == "<<<") {
+                state = HEADER;
+            } else if (state == HEADER && line.empty()) {
+                state = INPUT;
+                result.emplace_back();
+            } else if (state == INPUT) {
+                result.back().append(line).append("\n");
+            }
+        }
+        if (state == INPUT) {
+            finish();
+        }
+        return result;
+    }
+}
 
 namespace units {
 
@@ -12,125 +145,562 @@ namespace units {
         }
     }
 
-    bool generator::readNextTestFromFile(std::string &test) {
-        size_t delimiters = 0;
-        char c[2]{0}; // [1 prev_char, 0 cur_char]
+    generator::~generator() {
+        {
+            std::lock_guard lck(mutex);
+            stopped = true;
+        }
+        prefetchCond.notify_all();
 
-        // trim
-        while (!reader.eof()) {
-            c[1] = c[0];
-            if (!(reader >> c[0])) {
-                break;
+        if (prefetcher.joinable()) {
+            prefetcher.join();
+        }
+        if (watching.joinable()) {
+            watching.join();
+        }
+    }
+
+    bool generator::readTestFromFile(uint32_t id, std::string &test) {
+        if (id < tests.size()) {
+            test.assign(tests[id]);
+        }
+        return true;
+    }
+
+    bool generator::readTestFromDir(uint32_t id, std::string &test) {
+        if (archive) {
+            return id >= archive->members.size() || readCompressed(archive->members[id].data, test);
+        }
+        if (id >= files.size()) {
+            return true;
+        }
+
+        size_t prefix = test.size();
+        if (!readFile(files[id], test)) {
+            return false;
+        }
+
+        // read as is, most of tests are not compressed
+        if (compression::detect(std::string_view(test).substr(prefix)) != compression::format::NONE) {
+            std::string raw = test.substr(prefix);
+            test.resize(prefix);
+            return readCompressed(raw, test);
+        }
+        return true;
+    }
+
+    bool generator::readCompressed(std::string_view data, std::string &test) const {
+        std::string error;
+        if (!compression::decompress(data, test, error)) {
+            terminal::syncOutput("[!] Unable to decompress a test of ", toString(), ": ", error, '\n');
+            return false;
+        }
+        return true;
+    }
+
+    bool generator::takeTestFromDir(test_result &test) {
+        std::unique_lock lck(mutex);
+
+        // start reading ahead of the first test taken, it may be not
+        // the first one of the session if it is resumed
+        if (!prefetcher.joinable()) {
+            prefetchOrdinal = test.ordinal + 1;
+            prefetcher = std::thread(&generator::prefetch, this);
+        } else {
+            prefetchOrdinal = std::max(prefetchOrdinal, test.ordinal + 1);
+        }
+        prefetchCond.wait(lck, [&] { return reading != test.id; });
+
+        auto it = prefetched.find(test.id);
+        if (it != prefetched.end()) {
+            prefetchedBytes -= it->second.size();
+            test.input = std::move(it->second);
+            prefetched.erase(it);
+            prefetchCond.notify_all();
+            return true;
+        }
+
+        // workers are ahead of prefetching
+        lck.unlock();
+        return readTestFromDir(test.id, test.input);
+    }
+
+    bool generator::takeTestFromWatchedDir(test_result &test) {
+        std::unique_lock lck(mutex);
+
+        // test is taken as soon as its file appears
+        while (test.id >= files.size() && !stopped && !terminal::interrupted()) {
+            prefetchCond.wait_for(lck, std::chrono::milliseconds(WATCH_INTERVAL_MS));
+        }
+        if (test.id >= files.size()) {
+            return true;
+        }
+
+        // list of files grows, so the path is copied
+        std::filesystem::path path = files[test.id];
+        lck.unlock();
+        return readFile(path, test.input);
+    }
+
+    void generator::watch() {
+        std::vector<std::filesystem::path> created;
+
+        while (true) {
+            bool ok = watcher->wait(created, WATCH_INTERVAL_MS);
+            std::lock_guard lck(mutex);
+
+            if (stopped || !ok) {
+                return;
             }
-            if (c[0] != '\r' && c[0] != '\n') {
-                test += c[0];
-                break;
+
+            // files written while the directory was listed are known already
+            for (auto &path: created) {
+                if (knownFiles.insert(path).second) {
+                    files.push_back(std::move(path));
+                }
             }
+            created.clear();
+            prefetchCond.notify_all();
         }
+    }
 
-        while (!reader.eof()) {
-            c[1] = c[0];
-            if (!(reader >> c[0])) { // todo: check correctness
-                break;
+    void generator::prefetch() {
+        std::unique_lock lck(mutex);
+
+        while (true) {
+            prefetchCond.wait(lck, [this] {
+                return stopped || (prefetchOrdinal < order.size()
+                                   && prefetched.size() < PREFETCH_FILES
+                                   && prefetchedBytes < PREFETCH_BYTES);
+            });
+
+            if (stopped) {
+                return;
             }
+            uint32_t id = order[prefetchOrdinal++];
+            reading = id;
+            lck.unlock();
 
-            if (c[0] == '\r') {
-                ++delimiters;
-                if (c[1] == '\r') {
-                    break;
-                }
-                if (delimiters == 2) {
-                    continue;
-                }
-            } else if (c[0] == '\n') {
-                if (c[1] != '\r') {
-                    ++delimiters;
-                }
-                if (delimiters == 2) {
-                    break;
-                }
-            } else {
-                if (delimiters == 2 && c[1] == '\r') {
-                    test += c[1];
-                }
-                delimiters = 0;
+            std::string test;
+            bool ok = readTestFromDir(id, test);
+
+            // if it failed, worker will read it again and report
+            lck.lock();
+            reading.reset();
+            if (ok) {
+                prefetchedBytes += test.size();
+                prefetched.emplace(id, std::move(test));
             }
-            test += c[0];
+            prefetchCond.notify_all();
         }
+    }
 
-        return reader.good() || reader.eof();
+    bool generator::indexFile() {
+        // remember where each test is to read them by index
+        if (!mapping.open(file)) {
+            return false;
+        }
+        std::string_view data = mapping.view();
+        size_t pos = 0;
+
+        // compressed file can't be indexed, so it is unpacked into memory once
+        if (compression::detect(data) != compression::format::NONE) {
+            std::string error;
+            if (!compression::decompress(data, decompressed, error)) {
+                throw std::runtime_error("[!] Unable to decompress " + toString() + ": " + error);
+            }
+            data = decompressed;
+        }
+
+        for (std::string_view test; !(test = tests_file::nextTest(data, pos)).empty();) {
+            tests.push_back(test);
+        }
+        return true;
     }
 
-    bool generator::readNextTestFromDir(std::string &test) {
-        // go to the least file
-        while (iter != iter_end && !iter->is_regular_file()) ++iter;
-        if (iter == iter_end) {
+    bool generator::indexDir(runtime_config &cfg) {
+        if (archive) {
+            std::sort(archive->members.begin(), archive->members.end(), [](auto const &a, auto const &b) {
+                return naturalLess(a.name, b.name);
+            });
+            makeOrder(cfg, archive->members.size());
             return true;
         }
-        reader.close();
-        reader.open(iter->path(), std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
-        if (reader.bad()) {
+
+        std::vector<std::pair<std::string, std::filesystem::path>> entries;
+        std::error_code errCode;
+
+        // type of entry is known from listing, so there is no stat() for each file
+        for (auto const &entry: std::filesystem::directory_iterator(file, errCode)) {
+            if (entry.is_regular_file()) {
+                entries.emplace_back(entry.path().filename().string(), entry.path());
+            }
+        }
+        if (errCode) {
             return false;
         }
-        std::ifstream::pos_type pos = reader.tellg();
-        std::vector<char> result(pos);
 
-        reader.seekg(0, std::ios::beg);
-        reader.read(&result[0], pos);
+        std::sort(entries.begin(), entries.end(), [](auto const &a, auto const &b) {
+            return naturalLess(a.first, b.first);
+        });
 
-        if (reader.bad()) {
-            return false;
+        files.reserve(entries.size());
+        for (auto &[name, path]: entries) {
+            files.push_back(std::move(path));
         }
-        test.append(result.begin(), result.end());
 
-        // go to next file
-        ++iter;
+        // order of new files is unknown, so they are not read ahead
+        if (cfg.watch) {
+            knownFiles.insert(files.begin(), files.end());
+            watching = std::thread(&generator::watch, this);
+            return true;
+        }
+
+        makeOrder(cfg, files.size());
         return true;
     }
 
+    void generator::makeOrder(runtime_config &cfg, size_t testsCount) {
+        // tests of this shard in order of starting
+        uint32_t count = session::shardTestsCount(cfg);
+        for (uint32_t ordinal = 0; ordinal < count; ++ordinal) {
+            uint32_t id = session::testId(cfg, ordinal);
+            if (cfg.replay.empty() && id >= testsCount) {
+                break;
+            }
+            order.push_back(id);
+        }
+    }
+
+    void generator::loadCorpus(runtime_config &cfg) {
+        std::ifstream in(cfg.corpusPath, std::ios::binary);
+        uint64_t hash;
+
+        while (in.read((char *) &hash, sizeof(hash))) {
+            seen.emplace(hash, -1);
+        }
+    }
+
+    bool generator::isDuplicate(test_result &test) {
+        test.inputHash = pack::hash(test.input);
+        std::lock_guard lck(seenMutex);
+
+        // tests may be made out of order by workers, so a test is a duplicate
+        // only if the same input is made by a preceding one
+        auto [it, inserted] = seen.emplace(test.inputHash, test.ordinal);
+        if (!inserted && test.ordinal < it->second) {
+            it->second = test.ordinal;
+        }
+        return it->second < test.ordinal;
+    }
+
     bool generator::prepare(runtime_config &cfg) {
+        if (!cfg.corpusPath.empty()) {
+            loadCorpus(cfg);
+        }
+
         if (cat == tests_source::EXECUTABLE) {
             return unit::prepare(cfg);
 
+        } else if (cat == tests_source::FILE && (file == "-" || std::filesystem::is_fifo(file))) {
+            stream = std::make_unique<test_stream>(file, cfg.shardIndex, cfg.shardsCount);
+
         } else if (cat == tests_source::FILE) {
             requireExistence();
-            reader.open(file, std::ios_base::in | std::ios_base::binary);
-            reader.unsetf(std::ios_base::skipws);
+            return indexFile();
+
+        } else if (cat == tests_source::DIR && std::filesystem::is_regular_file(file)) {
+            archive = std::make_unique<tar_archive>();
+            if (!archive->open(file)) {
+                throw std::runtime_error("[!] " + toString() + " is not a tar archive");
+            }
+            if (cfg.watch) {
+                throw std::runtime_error("[!] Only directory of tests can be watched");
+            }
+            return indexDir(cfg);
 
         } else if (cat == tests_source::DIR) {
             if (!std::filesystem::is_directory(file)) {
                 throw std::runtime_error("[!] " + toString() + " is not a directory");
             }
-            iter = std::filesystem::directory_iterator(file);
+            // watched before listing, so no file is missed
+            if (cfg.watch) {
+                watcher = std::make_unique<dir_watcher>(file);
+            }
+            return indexDir(cfg);
+
+        } else if (cat == tests_source::PACK) {
+            requireExistence();
+            if (!packReader.open(file)) {
+                throw std::runtime_error("[!] " + toString() + " is not a pack of tests");
+            }
+            // tests of another version of the generator may be told apart
+            terminal::syncOutput("[*] Pack of ", packReader.size(), " tests of generator ",
+                                 pack::hex(packReader.generatorHash), '\n');
+
+        } else if (cat == tests_source::SPEC) {
+            requireExistence();
+            testSpec = spec::parse(file);
+
+        } else if (cat == tests_source::MUTATE) {
+            loadMutationSeeds(cfg);
+
+        } else if (cat == tests_source::PLUGIN) {
+            requireExistence();
+            if (!plugin.open(file)) {
+                throw std::runtime_error("[!] Unable to load " + toString() + ": " + plugin.error());
+            }
+
+            pluginGenerate = (stress_generate_t) plugin.symbol(STRESS_GENERATE_SYMBOL);
+            if (pluginGenerate == nullptr) {
+                throw std::runtime_error(
+                        "[!] " + toString() + " doesn't export " + STRESS_GENERATE_SYMBOL);
+            }
         }
         return true;
     }
 
-    void generator::execute(runtime_config &cfg, test_result &test) {
-        if (cat == tests_source::EXECUTABLE) {
-            const std::string seed = std::to_string(test.seed);
-            if (!invoker::execute(cfg, *this, seed, test.input, test.err, test.execResult)) {
+    bool generator::generate(runtime_config &cfg, std::string const &seeds, test_result &test) {
+        if (!invoker::execute(cfg, *this, seeds, test.input, test.err, test.execResult)) {
+            test.verdict = verdict::GENERATOR_FAILED;
+            return false;
+        }
+        if (test.execResult.error.hasError()) {
+            test.verdict = verdict::GENERATOR_RE;
+            return false;
+        }
+        return true;
+    }
+
+    void generator::generateInProcess(test_result &test) {
+        stress_sink sink{&test.input, [](void *context, char const *data, size_t size) {
+            static_cast<std::string *>(context)->append(data, size);
+        }};
+
+        if (int code = pluginGenerate(test.seed, &sink); code != 0) {
+            test.verdict = verdict::GENERATOR_RE;
+            test.execResult.error.storeExplanation("Plugin returned " + std::to_string(code));
+        }
+    }
+
+    void generator::loadMutationSeeds(runtime_config &cfg) {
+        mutations = std::make_unique<mutator>(cfg.worst);
+
+        if (std::filesystem::is_directory(file)) {
+            std::vector<std::filesystem::path> paths;
+            for (auto const &entry: std::filesystem::directory_iterator(file)) {
+                if (entry.is_regular_file()) {
+                    paths.push_back(entry.path());
+                }
+            }
+            std::sort(paths.begin(), paths.end(), [](auto const &a, auto const &b) {
+                return naturalLess(a.filename().string(), b.filename().string());
+            });
+            for (auto const &path: paths) {
+                std::string test;
+                if (!readFile(path, test)) {
+                    throw std::runtime_error("[!] Unable to read " + path.string());
+                }
+                if (!test.empty()) {
+                    mutations->add(std::move(test));
+                }
+            }
+        } else {
+            requireExistence();
+            std::string data;
+            if (!readFile(file, data)) {
+                throw std::runtime_error("[!] Unable to read " + toString());
+            }
+
+            // logs of failed tests are the best place to start from
+            if (data.find("------- TEST ") != std::string::npos) {
+                for (auto &test: loggedTests(data)) {
+                    mutations->add(std::move(test));
+                }
+            } else {
+                size_t pos = 0;
+                for (std::string_view test; !(test = tests_file::nextTest(data, pos)).empty();) {
+                    mutations->add(std::string(test));
+                }
+            }
+        }
+
+        if (mutations->empty()) {
+            throw std::runtime_error("[!] There are no tests to mutate in " + toString());
+        }
+    }
+
+    void generator::mutate(runtime_config &cfg, test_result &test) {
+        auto const &v = cfg.units.at(unit_category::VALIDATOR);
+
+        for (uint32_t attempt = 0; attempt < MAX_MUTATION_ATTEMPTS; ++attempt) {
+            test.input = mutations->mutate(test.seed, attempt);
+            if (v->empty()) {
+                return;
+            }
+
+            test_result checked;
+            checked.input = test.input;
+
+            memory_budget *budget = validatorBudget;
+            uint64_t reserved = budget ? budget->acquire(*v) : 0;
+            v->execute(cfg, checked);
+            if (budget) {
+                budget->release(*v, reserved, checked);
+            }
+
+            if (checked.verdict == verdict::GENERATOR_FAILED) {
                 test.verdict = verdict::GENERATOR_FAILED;
+                return;
+            } else if (checked.verdict == verdict::ACCEPTED) {
+                return;
+            }
+        }
+
+        // known tests are valid
+        test.input = mutations->original(test.seed);
+    }
+
+    void generator::learn(test_result const &test) {
+        if (mutations) {
+            mutations->learn(test);
+        }
+    }
+
+    void generator::useBudget(memory_budget &budget) {
+        validatorBudget = &budget;
+    }
+
+    void generator::takeGeneratedTest(runtime_config &cfg, test_result &test) {
+        uint32_t batch = test.ordinal / cfg.batchSize;
+        std::unique_lock lck(mutex);
+
+        // someone else is making this test
+        batchCond.wait(lck, [&] { return !generatingBatches.count(batch); });
+
+        auto it = generated.find(test.ordinal);
+        if (it != generated.end()) {
+            test.input = std::move(it->second);
+            generated.erase(it);
+            return;
+        }
+
+        // not made yet, or taken by the previous attempt of this test
+        generatingBatches.insert(batch);
+        lck.unlock();
+
+        generateBatch(cfg, batch, test);
+
+        lck.lock();
+        generatingBatches.erase(batch);
+
+        // tests of old batches given to other machines, or interrupted ones
+        while (generated.size() > MAX_GENERATED_TESTS) {
+            generated.erase(generated.begin());
+        }
+        batchCond.notify_all();
+    }
+
+    void generator::generateBatch(runtime_config &cfg, uint32_t batch, test_result &test) {
+        uint32_t first = batch * cfg.batchSize;
+        uint32_t last = std::min(first + cfg.batchSize, session::shardTestsCount(cfg));
+
+        // count of tests, then seed of each one
+        std::string seeds = std::to_string(last - first) + '\n';
+        for (uint32_t ordinal = first; ordinal < last; ++ordinal) {
+            seeds += std::to_string(session::testSeed(cfg, ordinal)) + '\n';
+        }
+
+        std::string output;
+        std::swap(output, test.input);
+        bool ok = generate(cfg, seeds, test);
+        std::swap(output, test.input);
+
+        if (!ok) {
+            return;
+        }
+
+        // each test is followed by a line with the delimiter only
+        std::vector<std::string> tests;
+        size_t begin = 0;
+
+        for (size_t end; (end = output.find(BATCH_DELIMITER, begin)) != std::string::npos;) {
+            tests.push_back(output.substr(begin, end - begin));
+            begin = output.find('\n', end);
+            begin = begin == std::string::npos ? output.size() : begin + 1;
+        }
+
+        if (tests.size() != last - first) {
+            test.verdict = verdict::GENERATOR_RE;
+            test.execResult.error.storeExplanation(
+                    "Expected " + std::to_string(last - first) + " tests from generator, got "
+                    + std::to_string(tests.size()));
+            return;
+        }
+
+        std::lock_guard lck(mutex);
+        for (uint32_t ordinal = first; ordinal < last; ++ordinal) {
+            if (ordinal == test.ordinal) {
+                test.input = std::move(tests[ordinal - first]);
+            } else {
+                generated[ordinal] = std::move(tests[ordinal - first]);
             }
-            if (test.execResult.error.hasError()) {
+        }
+    }
+
+    void generator::execute(runtime_config &cfg, test_result &test) {
+        if (cat == tests_source::EXECUTABLE && cfg.batchSize > 1) {
+            takeGeneratedTest(cfg, test);
+
+        } else if (cat == tests_source::EXECUTABLE && !cfg.sizes.empty()) {
+            generate(cfg, std::to_string(test.seed) + '\n'
+                          + std::to_string(complexity::testSize(cfg, test.id)), test);
+
+        } else if (cat == tests_source::EXECUTABLE) {
+            generate(cfg, std::to_string(test.seed), test);
+
+        } else if (cat == tests_source::PLUGIN) {
+            generateInProcess(test);
+
+        } else if (cat == tests_source::SPEC) {
+            std::string error;
+            if (!testSpec->generate(test.seed, test.input, error)) {
                 test.verdict = verdict::GENERATOR_RE;
+                test.execResult.error.storeExplanation(error);
+                terminal::syncOutput("[!] Unable to make test ", test.id + 1, ": ", error, '\n');
+            }
+
+        } else if (cat == tests_source::MUTATE) {
+            mutate(cfg, test);
+
+        } else if (cat == tests_source::FILE && stream) {
+            if (!stream->take(test.id, test.input)) {
+                test.verdict = verdict::TESTS_OVER;
             }
         } else if (cat == tests_source::FILE) {
-            std::lock_guard lck(mutex);
-            if (!readNextTestFromFile(test.input)) {
+            if (!readTestFromFile(test.id, test.input)) {
                 test.verdict = verdict::TESTS_READ_ERROR;
             }
             if (test.input.empty()) {
                 test.verdict = verdict::TESTS_OVER;
             }
         } else if (cat == tests_source::DIR) {
-            std::lock_guard lck(mutex);
-            if (!readNextTestFromDir(test.input)) {
+            if (!(watcher ? takeTestFromWatchedDir(test) : takeTestFromDir(test))) {
                 test.verdict = verdict::TESTS_READ_ERROR;
             }
             if (test.input.empty()) {
                 test.verdict = verdict::TESTS_OVER;
             }
+        } else if (cat == tests_source::PACK) {
+            // seed is the one test was generated with
+            if (!packReader.read(test.id, test.input, test.seed)) {
+                test.verdict = verdict::TESTS_OVER;
+            }
+        }
+
+        if (cfg.dedup && !test.verdict.isCriticalError() && test.verdict != verdict::TESTS_OVER
+            && isDuplicate(test)) {
+            test.verdict = verdict::DUPLICATE;
         }
     }
 }
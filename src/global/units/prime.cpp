@@ -2,6 +2,7 @@
 #include "core/runtime_config.h"
 #include "core/run.h"
 #include "invoker.h"
+#include "terminal.h"
 
 namespace units {
 
@@ -9,14 +10,48 @@ namespace units {
 
     prime::prime(proto_unit const& u) : unit(u) {}
 
+    bool prime::prepare(runtime_config &cfg) {
+        if (!unit::prepare(cfg)) {
+            return false;
+        }
+
+        // the compiled program is hashed, so the cache is dropped on any change
+        if (cfg.primeCache) {
+            cache = std::make_unique<output_cache>(file);
+        }
+        return true;
+    }
+
     void prime::execute(runtime_config &cfg, test_result &test) {
-        if (!invoker::execute(cfg, *this, test.input, test.output2, test.err, test.execResult)) {
+        if (cache && cache->load(test.input, test.output2, test.execResult)) {
+            test.primeTime = test.execResult.time;
+            test.primeMemory = test.execResult.memory;
+            checkLimits(cfg, test);
+            return;
+        }
+
+        bool started = invoker::execute(cfg, *this, test.input, test.output2, test.err, test.execResult);
+        test.primeTime = test.execResult.time;
+        test.primeMemory = test.execResult.memory;
+
+        if (!started) {
             test.verdict = verdict::PRIME_FAILED;
         }
         else if (test.execResult.error.hasError()) {
             test.verdict = verdict::PRIME_RE;
         }
-        else if (cfg.prime.timeLimit != 0 && test.execResult.time > cfg.prime.timeLimit) {
+        else {
+            // limits are checked on reuse, so they may be changed later
+            if (cache && caching && !cache->store(test.input, test.output2, test.execResult)
+                && caching.exchange(false)) {
+                terminal::syncOutput("[!] Unable to cache an output of prime, caching stopped\n");
+            }
+            checkLimits(cfg, test);
+        }
+    }
+
+    void prime::checkLimits(runtime_config &cfg, test_result &test) const {
+        if (cfg.prime.timeLimit != 0 && test.execResult.time > cfg.prime.timeLimit) {
             test.verdict = verdict::SKIPPED;
         }
         else if (cfg.prime.memoryLimit != 0 && test.execResult.memory > cfg.prime.memoryLimit) {
@@ -2,22 +2,44 @@
 #include "core/runtime_config.h"
 #include "core/run.h"
 #include "invoker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // limit is a few times the time of prime, but not less than the floor
+    // and not more than the absolute limit, if it's set
+    size_t relativeTimeLimit(runtime_config const &cfg, size_t primeTime) {
+        auto limit = (size_t) std::ceil(cfg.relativeTimeLimit * (double) primeTime);
+        limit = std::max<size_t>(limit, cfg.timeLimitFloor);
+        return cfg.timeLimit ? std::min<size_t>(limit, cfg.timeLimit) : limit;
+    }
+}
 
 namespace units {
 
     to_test::to_test(const struct proto_unit &u) : unit(u) {}
 
     void to_test::execute(runtime_config &cfg, test_result &test) {
-        if (!invoker::execute(cfg, *this, test.input, test.output, test.err, test.execResult)) {
+        // limits of the unit are shared by workers, so the limit of this test is set to a copy
+        to_test limited(*this);
+        if (cfg.relativeTimeLimit > 0) {
+            limited.timeLimit = test.timeLimit = relativeTimeLimit(cfg, test.primeTime);
+        }
+
+        bool started = invoker::execute(cfg, limited, test.input, test.output, test.err, test.execResult);
+        test.solutionTime = test.execResult.time;
+        test.solutionMemory = test.execResult.memory;
+
+        if (!started) {
             test.verdict = verdict::TO_TEST_FAILED;
         }
         else if (test.execResult.error.hasError()) {
             test.verdict = verdict::RUNTIME_ERROR;
         }
-        else if (cfg.toTest.timeLimit != 0 && test.execResult.time > cfg.toTest.timeLimit) {
+        else if (limited.timeLimit != 0 && test.execResult.time > limited.timeLimit) {
             test.verdict = verdict::TIME_LIMIT;
         }
-        else if (cfg.toTest.memoryLimit != 0 && test.execResult.memory > cfg.toTest.memoryLimit) {
+        else if (limited.memoryLimit != 0 && test.execResult.memory > limited.memoryLimit) {
             test.verdict = verdict::MEMORY_LIMIT;
         }
         else {
@@ -21,6 +21,8 @@ namespace units {
                 return "prime solution";
             case unit_category::VERIFIER:
                 return "verifier";
+            case unit_category::VALIDATOR:
+                return "validator";
             default:
                 throw std::runtime_error("[!] Unknown category");
         }
@@ -0,0 +1,23 @@
+#include "units/validator.h"
+#include "core/runtime_config.h"
+#include "core/run.h"
+#include "invoker.h"
+
+namespace units {
+
+    validator::validator(const struct proto_unit &u) : unit(u) {}
+
+    void validator::execute(runtime_config &cfg, test_result &test) {
+        std::string output;
+        if (!invoker::execute(cfg, *this, test.input, output, test.err, test.execResult)) {
+            test.verdict = verdict::GENERATOR_FAILED;
+        }
+        else if (test.execResult.error.hasError()) {
+            test.verdict = verdict::SKIPPED;
+        }
+        else {
+            test.verdict = verdict::ACCEPTED;
+        }
+    }
+
+}
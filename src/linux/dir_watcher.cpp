@@ -0,0 +1,51 @@
+#include "dir_watcher.h"
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+
+// dir_watcher implementation
+
+dir_watcher::dir_watcher(path const &dir) : dir(dir) {
+    handle = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+
+    // files are taken when they are closed after writing or moved in whole
+    if (handle == -1 || inotify_add_watch((int) handle, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        throw std::runtime_error(
+                "[!] Unable to watch " + dir.string() + ", error " + std::to_string(errno));
+    }
+}
+
+bool dir_watcher::wait(std::vector<path> &created, uint32_t timeoutMs) {
+    pollfd p{(int) handle, POLLIN, 0};
+    int ret = poll(&p, 1, (int) timeoutMs);
+
+    if (ret == -1) {
+        return errno == EINTR;
+    } else if (ret == 0) {
+        return true;
+    }
+
+    alignas(inotify_event) char buf[64 * 1024];
+
+    while (true) {
+        ssize_t size = read((int) handle, buf, sizeof(buf));
+        if (size <= 0) {
+            return size == 0 || errno == EAGAIN || errno == EINTR;
+        }
+
+        for (char *i = buf; i < buf + size;) {
+            auto *event = (inotify_event *) i;
+            if (event->len > 0 && !(event->mask & IN_ISDIR)) {
+                created.push_back(dir / event->name);
+            }
+            i += sizeof(inotify_event) + event->len;
+        }
+    }
+}
+
+dir_watcher::~dir_watcher() {
+    if (handle != -1) {
+        close((int) handle);
+    }
+}
@@ -8,8 +8,10 @@
 #include "core/runtime_config.h"
 #include "linux/core/error_info.h"
 #include <sys/wait.h>
+#include <sched.h>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <thread>
 #include <sys/ptrace.h>
 #include <sys/resource.h>
@@ -234,16 +236,18 @@ namespace {
 
             // wait4 is not standardized on Linux
             while ((child = wait4(-pg, &status, WNOHANG, &rusage)) == 0) {
-                elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
-
-                if (terminal::interrupted()
-                    || (unit.timeLimit != 0 && elapsed > unit.timeLimit)
-                    || (unit.memoryLimit != 0 && rusage.ru_maxrss * 1024ull > unit.memoryLimit)) { // todo: avoid multiplication
-                    terminatedByWatcher = true;
-                    for (auto victim: threads) {
-                        kill(victim, SIGKILL);
+                // killed process is still waited for, otherwise its status is unknown
+                if (!terminatedByWatcher) {
+                    elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+                    if (terminal::interrupted()
+                        || (unit.timeLimit != 0 && elapsed > unit.timeLimit)
+                        || (unit.memoryLimit != 0 && rusage.ru_maxrss * 1024ull > unit.memoryLimit)) { // todo: avoid multiplication
+                        terminatedByWatcher = true;
+                        for (auto victim: threads) {
+                            kill(victim, SIGKILL);
+                        }
                     }
-                    break;
                 }
 
                 usleep(WATCHER_INTERVAL_US);
@@ -353,8 +357,9 @@ namespace {
             }
         }
 
-        // prevent 0 ms in stats
-        if (elapsed == 0) {
+        // the watcher looks at the time only once in a while,
+        // so the time of the exit is taken when it's known
+        if (!terminatedByWatcher) {
             elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
         }
 
@@ -382,6 +387,10 @@ namespace invoker {
 }
 
 namespace invoker {
+    uint64_t processId() {
+        return (uint64_t) getpid();
+    }
+
     bool execute(runtime_config const &cfg,
                  units::unit const &unit,
                  std::string const &in,
@@ -395,7 +404,9 @@ namespace invoker {
         HandleWrapper STDIN_PIPE[2];
         int pipesTmp[2];
 
-        if (pipe(pipesTmp) < 0) {
+        // close-on-exec, otherwise processes started at the same time
+        // by other workers inherit them and hold stdin of each other open
+        if (pipe2(pipesTmp, O_CLOEXEC) < 0) {
             terminal::syncOutput(
                     "[!] Execution preparing failed, error ", errno, '\n');
             return false;
@@ -404,7 +415,7 @@ namespace invoker {
         STDIN_PIPE[0].handle = pipesTmp[0];
         STDIN_PIPE[1].handle = pipesTmp[1];
 
-        if (pipe(pipesTmp) < 0) {
+        if (pipe2(pipesTmp, O_CLOEXEC) < 0) {
             terminal::syncOutput(
                     "[!] Execution preparing failed, error ", errno, '\n');
             return false;
@@ -413,7 +424,7 @@ namespace invoker {
         STDOUT_PIPE[0].handle = pipesTmp[0];
         STDOUT_PIPE[1].handle = pipesTmp[1];
 
-        if (pipe(pipesTmp) < 0) {
+        if (pipe2(pipesTmp, O_CLOEXEC) < 0) {
             return false;
         }
 
@@ -463,6 +474,14 @@ namespace invoker {
                 close(STDOUT_PIPE[1].release());
                 close(STDIN_PIPE[0].release());
 
+                // the solution is benchmarked on a single core
+                if (unit.cat == units::unit_category::TO_TEST && cfg.pinnedCore) {
+                    cpu_set_t cpus;
+                    CPU_ZERO(&cpus);
+                    CPU_SET(*cfg.pinnedCore, &cpus);
+                    sched_setaffinity(0, sizeof(cpus), &cpus);
+                }
+
                 if (setpgid(0, 0) == 0) {
                     * (volatile pid_t*) pg = getpgid(0);
                     execvp(args[0], args.data());
@@ -0,0 +1,39 @@
+#include "mapped_file.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// mapped_file implementation
+
+bool mapped_file::open(std::filesystem::path const &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat st{};
+    bool ok = fstat(fd, &st) == 0;
+
+    // empty file can't be mapped, but it is fine
+    if (ok && st.st_size > 0) {
+        void *addr = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (addr == MAP_FAILED) {
+            ok = false;
+        } else {
+            data = (char const *) addr;
+            size = (size_t) st.st_size;
+            // tests are read once from the beginning to the end
+            madvise(addr, size, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);
+    return ok;
+}
+
+mapped_file::~mapped_file() {
+    if (data != nullptr) {
+        munmap((void *) data, size);
+    }
+}
@@ -0,0 +1,223 @@
+#include "net.h"
+#include "terminal.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace {
+    constexpr int POLL_INTERVAL_MS = 100;
+    constexpr int LISTEN_BACKLOG = 64;
+    constexpr char UNIX_PREFIX[] = "unix:";
+
+    bool isUnixAddress(std::string const &address) {
+        return address.rfind(UNIX_PREFIX, 0) == 0;
+    }
+
+    sockaddr_un unixAddress(std::string const &address) {
+        sockaddr_un addr{};
+        std::string path = address.substr(strlen(UNIX_PREFIX));
+
+        if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+            throw std::runtime_error("[!] Invalid unix socket path: " + path);
+        }
+        addr.sun_family = AF_UNIX;
+        memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        return addr;
+    }
+
+    // split "host:port" or "port"
+    addrinfo *resolve(std::string const &address, bool passive) {
+        size_t colon = address.rfind(':');
+        std::string host = colon == std::string::npos ? "" : address.substr(0, colon);
+        std::string port = colon == std::string::npos ? address : address.substr(colon + 1);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = passive ? AI_PASSIVE : 0;
+
+        addrinfo *result = nullptr;
+        int err = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+
+        if (err != 0) {
+            throw std::runtime_error(
+                    "[!] Unable to resolve " + address + ": " + gai_strerror(err));
+        }
+        return result;
+    }
+
+    // wait until handle is ready, false if interrupted
+    bool waitFor(int fd, short events) {
+        pollfd p{fd, events, 0};
+
+        while (true) {
+            int ret = poll(&p, 1, POLL_INTERVAL_MS);
+            if (terminal::interrupted()) {
+                return false;
+            } else if (ret > 0) {
+                return true;
+            } else if (ret == -1 && errno != EINTR) {
+                return false;
+            }
+        }
+    }
+}
+
+namespace net {
+
+    // socket implementation
+
+    bool socket::send(char const *data, size_t size) {
+        for (size_t pos = 0; pos < size;) {
+            ssize_t written = ::send((int) handle, data + pos, size - pos, MSG_NOSIGNAL);
+
+            if (written == -1) {
+                if (errno == EINTR && !terminal::interrupted()) {
+                    continue;
+                }
+                return false;
+            }
+            pos += (size_t) written;
+        }
+        return true;
+    }
+
+    bool socket::receive(char *data, size_t size) {
+        for (size_t pos = 0; pos < size;) {
+            if (!waitFor((int) handle, POLLIN)) {
+                return false;
+            }
+            ssize_t bytesRead = ::recv((int) handle, data + pos, size - pos, 0);
+
+            if (bytesRead == -1) {
+                if (errno == EINTR || errno == EAGAIN) {
+                    continue;
+                }
+                return false;
+            } else if (bytesRead == 0) {
+                // EOF
+                return false;
+            }
+            pos += (size_t) bytesRead;
+        }
+        return true;
+    }
+
+    handle_t socket::release() {
+        handle_t tmp = handle;
+        handle = -1;
+        return tmp;
+    }
+
+    socket::~socket() {
+        if (handle != -1) {
+            close((int) handle);
+        }
+    }
+
+    // listener implementation
+
+    listener::listener(std::string const &address) {
+        if (isUnixAddress(address)) {
+            sockaddr_un addr = unixAddress(address);
+            unixPath = addr.sun_path;
+            unlink(addr.sun_path); // stale socket of the previous run
+
+            handle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (handle == -1 || bind((int) handle, (sockaddr *) &addr, sizeof(addr)) == -1) {
+                throw std::runtime_error(
+                        "[!] Unable to bind " + address + ", error " + std::to_string(errno));
+            }
+        } else {
+            addrinfo *info = resolve(address, true);
+
+            for (addrinfo *i = info; i != nullptr; i = i->ai_next) {
+                handle = ::socket(i->ai_family, i->ai_socktype, i->ai_protocol);
+                if (handle == -1) {
+                    continue;
+                }
+                int yes = 1;
+                setsockopt((int) handle, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+                if (bind((int) handle, i->ai_addr, i->ai_addrlen) == 0) {
+                    break;
+                }
+                close((int) handle);
+                handle = -1;
+            }
+            freeaddrinfo(info);
+
+            if (handle == -1) {
+                throw std::runtime_error(
+                        "[!] Unable to bind " + address + ", error " + std::to_string(errno));
+            }
+        }
+
+        if (listen((int) handle, LISTEN_BACKLOG) == -1) {
+            throw std::runtime_error(
+                    "[!] Unable to listen " + address + ", error " + std::to_string(errno));
+        }
+    }
+
+    std::optional<socket> listener::accept(uint32_t timeoutMs) {
+        pollfd p{(int) handle, POLLIN, 0};
+
+        if (poll(&p, 1, (int) timeoutMs) <= 0) {
+            return std::nullopt;
+        }
+        int fd = ::accept((int) handle, nullptr, nullptr);
+
+        if (fd == -1) {
+            return std::nullopt;
+        }
+        return socket(fd);
+    }
+
+    listener::~listener() {
+        if (handle != -1) {
+            close((int) handle);
+        }
+        if (!unixPath.empty()) {
+            unlink(unixPath.c_str());
+        }
+    }
+
+    socket connect(std::string const &address) {
+        int fd = -1;
+
+        if (isUnixAddress(address)) {
+            sockaddr_un addr = unixAddress(address);
+            fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+            if (fd != -1 && ::connect(fd, (sockaddr *) &addr, sizeof(addr)) == -1) {
+                close(fd);
+                fd = -1;
+            }
+        } else {
+            addrinfo *info = resolve(address.find(':') == std::string::npos
+                                     ? "localhost:" + address : address, false);
+
+            for (addrinfo *i = info; i != nullptr; i = i->ai_next) {
+                fd = ::socket(i->ai_family, i->ai_socktype, i->ai_protocol);
+                if (fd == -1) {
+                    continue;
+                }
+                if (::connect(fd, i->ai_addr, i->ai_addrlen) == 0) {
+                    break;
+                }
+                close(fd);
+                fd = -1;
+            }
+            freeaddrinfo(info);
+        }
+
+        if (fd == -1) {
+            throw std::runtime_error(
+                    "[!] Unable to connect to " + address + ", error " + std::to_string(errno));
+        }
+        return socket(fd);
+    }
+}
@@ -0,0 +1,25 @@
+#include "shared_library.h"
+#include <dlfcn.h>
+
+// shared_library implementation
+
+bool shared_library::open(std::filesystem::path const &path) {
+    // relative path without slashes would be searched in system directories
+    handle = dlopen(std::filesystem::absolute(path).c_str(), RTLD_NOW | RTLD_LOCAL);
+    return handle != nullptr;
+}
+
+void *shared_library::symbol(char const *name) const {
+    return dlsym(handle, name);
+}
+
+std::string shared_library::error() const {
+    char const *err = dlerror();
+    return err ? err : "unknown error";
+}
+
+shared_library::~shared_library() {
+    if (handle != nullptr) {
+        dlclose(handle);
+    }
+}
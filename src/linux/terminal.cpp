@@ -36,8 +36,8 @@ void terminal_token::init() {
 
     bool ok = true;
 
-    auto setSignalHandler = [&sa, &ok](int) {
-        while (sigaction(SIGTERM, &sa, nullptr) == -1) {
+    auto setSignalHandler = [&sa, &ok](int sig) {
+        while (sigaction(sig, &sa, nullptr) == -1) {
             if (errno != EINTR) {
                 ok = false;
                 break;
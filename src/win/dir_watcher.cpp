@@ -0,0 +1,14 @@
+#include "dir_watcher.h"
+#include <stdexcept>
+
+// todo: implement with ReadDirectoryChangesW
+
+dir_watcher::dir_watcher(path const &) {
+    throw std::runtime_error("[!] Watching directories is not supported on Windows yet");
+}
+
+bool dir_watcher::wait(std::vector<path> &, uint32_t) {
+    return false;
+}
+
+dir_watcher::~dir_watcher() = default;
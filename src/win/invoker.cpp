@@ -104,7 +104,10 @@ namespace {
                && (unit.memoryLimit == 0 || memCounters.PeakWorkingSetSize <= unit.memoryLimit)) {
 
             if (WaitForSingleObject(hProcess, WATCHER_INTERVAL_MS) == WAIT_OBJECT_0) {
-                break; // process is dead
+                // process is dead, the time of its exit is known right now
+                elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
+                GetProcessMemoryInfo(hProcess, &memCounters, sizeof(memCounters));
+                break;
             }
 
             elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
@@ -209,6 +212,10 @@ namespace invoker {
 
 namespace invoker {
 
+    uint64_t processId() {
+        return (uint64_t) GetCurrentProcessId();
+    }
+
     bool execute(runtime_config const &cfg,
                  units::unit const &unit,
                  std::string const &in,
@@ -271,6 +278,11 @@ namespace invoker {
             return false;
         }
 
+        // the solution is benchmarked on a single core
+        if (unit.cat == units::unit_category::TO_TEST && cfg.pinnedCore) {
+            SetProcessAffinityMask(pi.hProcess, (DWORD_PTR) 1 << *cfg.pinnedCore);
+        }
+
         CloseHandle(STDIN_READ.release());
         CloseHandle(STDOUT_WRITE.release());
         CloseHandle(STDERR_WRITE.release());
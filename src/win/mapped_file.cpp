@@ -0,0 +1,43 @@
+#include "mapped_file.h"
+#include <windows.h>
+
+// mapped_file implementation
+
+bool mapped_file::open(std::filesystem::path const &path) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    bool ok = GetFileSizeEx(file, &fileSize);
+
+    // empty file can't be mapped, but it is fine
+    if (ok && fileSize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mapping == nullptr) {
+            ok = false;
+        } else {
+            // view holds a reference to the mapping
+            void *addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+
+            if (addr == nullptr) {
+                ok = false;
+            } else {
+                data = (char const *) addr;
+                size = (size_t) fileSize.QuadPart;
+            }
+        }
+    }
+    CloseHandle(file);
+    return ok;
+}
+
+mapped_file::~mapped_file() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+}
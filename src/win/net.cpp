@@ -0,0 +1,43 @@
+#include "net.h"
+#include <stdexcept>
+
+// todo: implement with winsock
+
+namespace {
+    [[noreturn]] void unsupported() {
+        throw std::runtime_error("[!] Cluster mode is not supported on Windows yet");
+    }
+}
+
+namespace net {
+
+    bool socket::send(char const *, size_t) {
+        unsupported();
+    }
+
+    bool socket::receive(char *, size_t) {
+        unsupported();
+    }
+
+    handle_t socket::release() {
+        handle_t tmp = handle;
+        handle = -1;
+        return tmp;
+    }
+
+    socket::~socket() = default;
+
+    listener::listener(std::string const &) {
+        unsupported();
+    }
+
+    std::optional<socket> listener::accept(uint32_t) {
+        unsupported();
+    }
+
+    listener::~listener() = default;
+
+    socket connect(std::string const &) {
+        unsupported();
+    }
+}
@@ -0,0 +1,23 @@
+#include "shared_library.h"
+#include <windows.h>
+
+// shared_library implementation
+
+bool shared_library::open(std::filesystem::path const &path) {
+    handle = (void *) LoadLibraryW(std::filesystem::absolute(path).c_str());
+    return handle != nullptr;
+}
+
+void *shared_library::symbol(char const *name) const {
+    return (void *) GetProcAddress((HMODULE) handle, name);
+}
+
+std::string shared_library::error() const {
+    return "error " + std::to_string(GetLastError());
+}
+
+shared_library::~shared_library() {
+    if (handle != nullptr) {
+        FreeLibrary((HMODULE) handle);
+    }
+}
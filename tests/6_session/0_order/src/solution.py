@@ -0,0 +1,5 @@
+import time
+n = int(input())
+# tests finish out of order when run by several workers
+time.sleep(0.01 * (n % 7))
+print(n if n % 4 else n + 1)
@@ -0,0 +1,27 @@
+import subprocess, sys, os, re
+
+
+def run(args, tag):
+    p = subprocess.run(["stress", "-g", "src/gen.py", "-n", "40", "-s", "5", "-c", "gtp", "-tag", tag] + args
+                       + ["src/solution.py", "src/prime.py"], capture_output=True, text=True)
+    log = ""
+    for entry in os.scandir("stress/logs"):
+        if entry.is_file() and entry.name.startswith(tag + "_"):
+            with open(entry.path) as f:
+                log = f.read()
+    # timings differ from run to run
+    strip = lambda s: re.sub(r"\d+ ms, [\d.]+ MB", "", s)
+    return strip("\n".join(re.findall(r"Test \d+, [^\n]*", p.stdout))), strip(log), p.stdout
+
+
+sequential, sequentialLog, out = run([], "sequential")
+if len(re.findall(r"Test \d+", sequential)) != 40 or "TEST" not in sequentialLog:
+    sys.stderr.write("sequential run is not complete:\n" + out)
+    exit(1)
+
+# results are reported and logged in order of tests, as if they were run one by one
+for workers in ["2", "8"]:
+    parallel, parallelLog, out = run(["-mt", "-w", workers], "parallel" + workers)
+    if parallel != sequential or parallelLog != sequentialLog:
+        sys.stderr.write("results of " + workers + " workers are out of order:\n" + out)
+        exit(1)
@@ -0,0 +1,6 @@
+import sys
+
+for line in sys.stdin:
+    if line.strip():
+        a, b = map(int, line.split())
+        print(a + b if a % 3 else 0)
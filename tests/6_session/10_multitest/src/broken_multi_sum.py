@@ -0,0 +1,3 @@
+for _ in range(int(input())):
+    a, b = map(int, input().split())
+    print(a + b if a % 3 else 0)
@@ -0,0 +1,7 @@
+with open("stress/runs.txt", "a") as f:
+    f.write("run\n")
+
+for _ in range(int(input())):
+    a, b = map(int, input().split())
+    print(a + b if a % 3 else 0)
+    print("---")
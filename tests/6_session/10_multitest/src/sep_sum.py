@@ -0,0 +1,4 @@
+for _ in range(int(input())):
+    a, b = map(int, input().split())
+    print(a + b)
+    print("---")
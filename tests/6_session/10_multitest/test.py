@@ -0,0 +1,53 @@
+import subprocess, sys, os, re
+
+prefix = "../1_replay/src/"
+
+
+def run(args, solutions):
+    p = subprocess.run(["stress", "-n", "50", "-s", "42", "-c", "gvtp", "-g", prefix + "gen.py"] + args + solutions,
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+
+
+def logged(tag):
+    for entry in os.scandir("stress/logs"):
+        if entry.is_file() and entry.name.startswith(tag + "_"):
+            with open(entry.path) as f:
+                return re.findall(r"TEST (\d+) -+\nseed: \d+\n.*\n\n(.*)\n(.*)\n", f.read())
+    return []
+
+
+single = run([], [prefix + "broken_sum.py", prefix + "sum.py"])
+grouped = run(["-mt", "-multitest", "16", "-tag", "grouped"], ["src/broken_multi_sum.py", "src/multi_sum.py"])
+
+# failed tests are found by bisection
+if len(single) != 50 or single != grouped:
+    sys.stderr.write("grouped tests differ:\n" + str(single) + "\n" + str(grouped))
+    exit(1)
+
+# only failed tests are logged, each as a group of one test
+failed = [t for t, v in single if v != "OK"]
+if [t for t, count, _ in logged("grouped")] != failed or any(count != "1" for _, count, _ in logged("grouped")):
+    sys.stderr.write("wrong log:\n" + str(logged("grouped")))
+    exit(1)
+
+# failed tests are found by outputs split by the separator, without running them again
+separated = run(["-multitest", "16", "-multitest-sep", "---", "-tag", "separated"],
+                ["src/broken_sep_sum.py", "src/sep_sum.py"])
+with open("stress/runs.txt") as f:
+    runs = len(f.readlines())
+if separated != single or runs != 4:
+    sys.stderr.write("outputs are not split:\n" + str(single) + "\n" + str(separated) + "\nruns: " + str(runs))
+    exit(1)
+if [t for t, count, _ in logged("separated")] != failed or any(count != "1" for _, count, _ in logged("separated")):
+    sys.stderr.write("wrong log of split outputs:\n" + str(logged("separated")))
+    exit(1)
+
+# tests are read until the end of input without count of them
+uncounted = run(["-mt", "-multitest", "16", "-multitest-no-count"], ["src/broken_eof_sum.py", "src/eof_sum.py"])
+if uncounted != single:
+    sys.stderr.write("tests without count differ:\n" + str(single) + "\n" + str(uncounted))
+    exit(1)
@@ -0,0 +1,8 @@
+import os
+
+# every run leaves a mark, so runs of prime can be counted
+with open(os.path.join(os.path.dirname(os.path.abspath(__file__)), "../stress/runs.txt"), "a") as f:
+    f.write("run\n")
+
+a, b = map(int, input().split())
+print(a + b)
@@ -0,0 +1,32 @@
+import subprocess, sys, os, re
+
+prefix = "../1_replay/src/"
+
+
+def run(solution):
+    p = subprocess.run(["stress", "-n", "20", "-s", "42", "-mt", "-c", "gvtp", "-pcache", "-g", prefix + "gen.py",
+                        solution, "src/counted_sum.py"], capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+
+
+def runs():
+    with open("stress/runs.txt") as f:
+        return len(f.readlines())
+
+
+os.makedirs("stress", exist_ok=True)
+first = run(prefix + "broken_sum.py")
+
+if len(first) != 20 or runs() != 20:
+    sys.stderr.write("prime is run " + str(runs()) + " times:\n" + str(first))
+    exit(1)
+
+# solution is changed, but the tests are the same, so prime is not run again
+second = run(prefix + "sum.py")
+
+if len(second) != 20 or any(v != "OK" for _, v in second) or runs() != 20:
+    sys.stderr.write("cached outputs are not reused, prime is run " + str(runs()) + " times:\n" + str(second))
+    exit(1)
@@ -0,0 +1,55 @@
+import subprocess, sys, re
+
+prefix = "../1_replay/src/"
+
+
+def run(args):
+    p = subprocess.run(["stress", "-n", "40", "-s", "42", "-c", "gvtp", "-g", "src/tiny_gen.py"] + args
+                       + [prefix + "sum.py", prefix + "sum.py"], capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def verdicts(out):
+    return re.findall(r"Test (\d+), +(.*?) *\n", out)
+
+
+def skipped(out):
+    m = re.search(r"Duplicates skipped: (\d+)", out)
+    return int(m.group(1)) if m else 0
+
+
+def count(out, verdict):
+    return [v for _, v in verdicts(out)].count(verdict)
+
+
+# there are only 9 different tests
+sequential = run(["-dedup"])
+if len(verdicts(sequential)) != 40 or count(sequential, "OK") != 9 \
+        or skipped(sequential) != count(sequential, "Duplicate"):
+    sys.stderr.write("duplicates are not skipped:\n" + sequential)
+    exit(1)
+
+# the first test of each input is run, even if workers made them out of order
+for workers in ["2", "4", "8"]:
+    out = run(["-dedup", "-mt", "-w", workers])
+    if verdicts(out) != verdicts(sequential) or skipped(out) != skipped(sequential):
+        sys.stderr.write("duplicates of workers differ:\n" + sequential + "\n" + out)
+        exit(1)
+
+# tests seen by the previous run are skipped
+first = run(["-corpus", "stress/corpus.bin", "-n", "5"])
+second = run(["-corpus", "stress/corpus.bin", "-n", "5"])
+if count(first, "OK") == 0 or [v for _, v in verdicts(second)] != ["Duplicate"] * 5:
+    sys.stderr.write("corpus is not used:\n" + first + "\n" + second)
+    exit(1)
+
+# a pack keeps only the first test of each input
+recorded = run(["-dedup", "-record", "stress/tests.pack"])
+p = subprocess.run(["stress", "-pack", "stress/tests.pack", "-n", "40", "-c", "gvtp", prefix + "sum.py", prefix + "sum.py"],
+                   capture_output=True, text=True)
+if p.returncode or "Pack of 9 tests" not in p.stdout or count(p.stdout, "OK") != 9:
+    sys.stderr.write("duplicates are recorded:\n" + recorded + "\n" + p.stdout)
+    exit(1)
@@ -0,0 +1,20 @@
+#include "generator_plugin.h"
+#include <stdio.h>
+
+static uint32_t next(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+int stress_generate(uint32_t seed, struct stress_sink const *sink) {
+    uint32_t state = seed | 1;
+    char buf[32];
+    int a = (int) (next(&state) % 2001) - 1000;
+    int b = (int) (next(&state) % 2001) - 1000;
+    int size = snprintf(buf, sizeof(buf), "%d %d\n", a, b);
+
+    sink->write(sink->context, buf, (size_t) size);
+    return 0;
+}
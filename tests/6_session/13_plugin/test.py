@@ -0,0 +1,34 @@
+import subprocess, sys, os, re
+
+prefix = "../1_replay/src/"
+
+
+def run(args):
+    p = subprocess.run(["stress", "-n", "100", "-s", "42", "-c", "gvtp", "-plugin", "stress/gen.so"] + args
+                       + [prefix + "broken_sum.py", prefix + "sum.py"], capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+
+
+os.makedirs("stress", exist_ok=True)
+build = subprocess.run(["cc", "-shared", "-fPIC", "-O2", "-I", "../../../include/global/units",
+                        "-o", "stress/gen.so", "src/gen_plugin.c"], capture_output=True, text=True)
+if build.returncode:
+    sys.stderr.write(build.stderr)
+    exit(build.returncode)
+
+single = run([])
+parallel = run(["-mt"])
+
+# tests depend only on seeds
+if len(single) != 100 or single != parallel or all(v == "OK" for _, v in single):
+    sys.stderr.write("plugin tests differ:\n" + str(single) + "\n" + str(parallel))
+    exit(1)
+
+failed = [t for t, v in single if v != "OK"]
+replayed = run(["-replay", ",".join(failed)])
+if [t for t, _ in replayed] != failed or any(v == "OK" for _, v in replayed):
+    sys.stderr.write("replay failed:\n" + str(replayed))
+    exit(1)
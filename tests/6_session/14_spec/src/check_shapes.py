@@ -0,0 +1,31 @@
+# prints ok only if the input has the shapes described by shapes.spec
+n, m = map(int, input().split())
+ok = 3 <= n <= 8 and 0 <= m <= n
+ok &= sorted(map(int, input().split())) == list(range(1, n + 1))
+a = list(map(int, input().split()))
+ok &= len(a) == n and all(-5 <= x <= 5 for x in a)
+s = input()
+ok &= len(s) == n and set(s) <= set("abc")
+
+parent = list(range(n + 1))
+
+
+def find(v):
+    while parent[v] != v:
+        v = parent[v]
+    return v
+
+
+for _ in range(n - 1):
+    u, v = map(int, input().split())
+    ok &= find(u) != find(v)
+    parent[find(u)] = find(v)
+
+edges = set()
+for _ in range(m):
+    u, v = map(int, input().split())
+    ok &= u != v and 1 <= min(u, v) and max(u, v) <= n
+    edges.add((min(u, v), max(u, v)))
+ok &= len(edges) == m
+ok &= input() == "7" and input() == "7"
+print("ok" if ok else "broken")
@@ -0,0 +1,3 @@
+# ends of edges still fit in a key, then they do not
+graph 4294967295 3
+graph 4294967296 1
@@ -0,0 +1,11 @@
+n = int 3 8
+m = int 0 n
+line n m
+line perm n
+line array n -5 5
+line string n a-c
+tree n
+graph n m
+repeat 2
+    line 7
+end
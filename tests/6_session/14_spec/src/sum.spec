@@ -0,0 +1,2 @@
+# the same tests as the ones of ../1_replay/src/gen.py, but made by stress
+line int -1000 1000 int -1000 1000
@@ -0,0 +1,34 @@
+import subprocess, sys, re
+
+prefix = "../1_replay/src/"
+
+
+def run(args, solutions):
+    p = subprocess.run(["stress", "-n", "100", "-s", "42", "-c", "gvtp"] + args + solutions,
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+
+
+single = run(["-spec", "src/sum.spec"], [prefix + "broken_sum.py", prefix + "sum.py"])
+parallel = run(["-spec", "src/sum.spec", "-mt"], [prefix + "broken_sum.py", prefix + "sum.py"])
+
+# tests depend only on seeds
+if len(single) != 100 or single != parallel or all(v == "OK" for _, v in single):
+    sys.stderr.write("spec tests differ:\n" + str(single) + "\n" + str(parallel))
+    exit(1)
+
+# all the shapes are made right
+shapes = run(["-spec", "src/shapes.spec", "-mt"], ["src/check_shapes.py", "src/ok.py"])
+if len(shapes) != 100 or any(v != "OK" for _, v in shapes):
+    sys.stderr.write("wrong shapes:\n" + str(shapes))
+    exit(1)
+
+# graph is refused before its count of pairs overflows
+p = subprocess.run(["stress", "-n", "1", "-c", "gvtp", "-spec", "src/huge_graph.spec", "src/ok.py", "src/ok.py"],
+                   capture_output=True, text=True)
+if "too many vertices for a graph: 4294967296" not in p.stdout or "GENERATOR RE" not in p.stdout:
+    sys.stderr.write("huge graph is made:\n" + p.stdout)
+    exit(1)
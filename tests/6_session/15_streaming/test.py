@@ -0,0 +1,99 @@
+import subprocess, sys, re, os, time, threading
+
+prefix = "../1_replay/src/"
+command = ["stress", "-mt", "-n", "100", "-c", "tp", prefix + "broken_sum.py", prefix + "sum.py"]
+tests = ["%d %d\n" % (i * 7 % 10, i * 3 % 10) for i in range(30)]
+
+
+def results(out):
+    return re.findall(r"Test (\d+), +(.*?) *\n", out)
+
+
+def check(name, out, expected):
+    if results(out) != expected:
+        sys.stderr.write(name + " differs:\n" + out)
+        exit(1)
+
+
+# kept in ./stress to be cleaned up
+os.makedirs("stress/watched", exist_ok=True)
+with open("stress/tests.txt", "w") as f:
+    f.write("\n".join(tests))
+
+expected = results(subprocess.run(command + ["-f", "stress/tests.txt"], capture_output=True, text=True).stdout)
+if len(expected) != 30 or all(v == "OK" for _, v in expected):
+    sys.stderr.write("wrong tests: " + str(expected))
+    exit(1)
+
+
+def produce(out):
+    # tests arrive by parts while the session goes on
+    for i, test in enumerate(tests):
+        out.write(test + "\n")
+        if i % 10 == 9:
+            out.flush()
+            time.sleep(0.2)
+    out.close()
+
+
+# tests from stdin
+p = subprocess.Popen(command + ["-f", "-"], stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True)
+producer = threading.Thread(target=produce, args=(p.stdin,))
+producer.start()
+out = p.stdout.read()
+p.wait()
+producer.join()
+check("stdin", out, expected)
+
+# tests from named pipe
+os.mkfifo("stress/fifo")
+producer = threading.Thread(target=lambda: produce(open("stress/fifo", "w")))
+producer.start()
+out = subprocess.run(command + ["-f", "stress/fifo"], capture_output=True, text=True).stdout
+producer.join()
+check("fifo", out, expected)
+
+# new files of watched directory are tested as they appear
+for i in range(10):
+    with open("stress/watched/%02d.txt" % i, "w") as f:
+        f.write(tests[i])
+
+p = subprocess.Popen(["stress", "-mt", "-n", "30", "-c", "tp", "-d", "stress/watched", "-watch",
+                      prefix + "broken_sum.py", prefix + "sum.py"], stdout=subprocess.PIPE, text=True)
+time.sleep(0.5)
+
+for i in range(10, 30):
+    # written aside and moved in whole
+    with open("stress/%02d.txt" % i, "w") as f:
+        f.write(tests[i])
+    os.rename("stress/%02d.txt" % i, "stress/watched/%02d.txt" % i)
+    time.sleep(0.02)
+
+try:
+    out = p.communicate(timeout=60)[0]
+except subprocess.TimeoutExpired:
+    p.kill()
+    sys.stderr.write("watching hangs")
+    exit(1)
+check("watched directory", out, expected)
+
+
+def inputs(tag):
+    for entry in os.scandir("stress/logs"):
+        if entry.name.startswith(tag + "_"):
+            with open(entry.path, newline="") as f:
+                return re.sub(r"verdict: [^\n]*", "", f.read())
+    return ""
+
+
+# bytes of tests from stdin are the same as from the file, whatever the line breaks are
+raw = b"1 2\r\n3 \r\n\r\n4 5\n\n\n6\r\r7\n8 \r\n\n9"
+with open("stress/raw.txt", "wb") as f:
+    f.write(raw)
+
+lengths = ["stress", "-n", "10", "-c", "tp", "src/length.py", "src/none.py"]
+subprocess.run(lengths + ["-f", "stress/raw.txt", "-tag", "file"], capture_output=True)
+subprocess.run(lengths + ["-f", "-", "-tag", "stdin"], input=raw, capture_output=True)
+if inputs("file").count("TEST") != 5 or inputs("file") != inputs("stdin"):
+    sys.stderr.write("tests from stdin differ:\n" + inputs("file") + "\n" + inputs("stdin"))
+    exit(1)
@@ -0,0 +1,78 @@
+import subprocess, sys, re, os, io, gzip, tarfile
+
+prefix = "../1_replay/src/"
+tests = ["%d %d\n" % (i * 7 % 10, i * 3 % 10) for i in range(12)]
+
+
+def run(args):
+    p = subprocess.run(["stress", "-mt", "-n", "100", "-c", "tp"] + args + [prefix + "broken_sum.py", prefix + "sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+
+
+def check(name, found, expected):
+    if found != expected:
+        sys.stderr.write(name + " differs:\n" + str(found) + "\n" + str(expected))
+        exit(1)
+
+
+# kept in ./stress to be cleaned up
+os.makedirs("stress", exist_ok=True)
+with open("stress/tests.txt", "w") as f:
+    f.write("\n".join(tests))
+
+expected = run(["-f", "stress/tests.txt"])
+if len(expected) != 12 or all(v == "OK" for _, v in expected):
+    sys.stderr.write("wrong tests: " + str(expected))
+    exit(1)
+
+# compressed file is the same as the plain one
+with gzip.open("stress/tests.txt.gz", "wt") as f:
+    f.write("\n".join(tests))
+check("gzip file", run(["-f", "stress/tests.txt.gz"]), expected)
+
+
+def add(tar, name, data):
+    info = tarfile.TarInfo(name)
+    info.size = len(data)
+    tar.addfile(info, io.BytesIO(data))
+
+
+# members are taken in natural order, some of them are compressed or have long names
+for fmt in [tarfile.PAX_FORMAT, tarfile.GNU_FORMAT, tarfile.USTAR_FORMAT]:
+    with tarfile.open("stress/tests.tar", "w", format=fmt) as tar:
+        for i in reversed(range(12)):
+            data = tests[i].encode()
+            if i % 3 == 0:
+                add(tar, "tests/%d.txt.gz" % i, gzip.compress(data))
+            elif i % 3 == 1 and fmt != tarfile.USTAR_FORMAT:
+                add(tar, "tests/" + "long" * 30 + "/%d.txt" % i, data)
+            else:
+                add(tar, "tests/%d.txt" % i, data)
+    found = run(["-d", "stress/tests.tar"])
+    if fmt != tarfile.USTAR_FORMAT:
+        # long names go after the short ones
+        order = [i for i in range(12) if i % 3 != 1] + [i for i in range(12) if i % 3 == 1]
+        found = [found[order.index(i)] for i in range(12)]
+        found = [(str(i + 1), v) for i, (_, v) in enumerate(found)]
+    check("tar archive", found, expected)
+
+# compressed files of directory
+os.makedirs("stress/dir", exist_ok=True)
+for i in range(12):
+    with open("stress/dir/%d.txt" % i, "wb") as f:
+        f.write(gzip.compress(tests[i].encode()) if i % 2 else tests[i].encode())
+check("directory", run(["-d", "stress/dir"]), expected)
+
+# other files are not read as empty archives
+for name, data in [("short", b"1 2\n"), ("zeros", bytes(10240)), ("text", ("3 4\n" * 1000).encode())]:
+    with open("stress/" + name + ".tar", "wb") as f:
+        f.write(data)
+    p = subprocess.run(["stress", "-n", "5", "-d", "stress/" + name + ".tar", "-c", "tp", prefix + "sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode == 0 or "is not a tar archive" not in p.stdout:
+        sys.stderr.write(name + " file is read as an archive:\n" + p.stdout)
+        exit(1)
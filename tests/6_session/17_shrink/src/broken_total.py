@@ -0,0 +1,2 @@
+import sys
+print(sum(x for x in map(int, sys.stdin.read().split()) if x <= 50))
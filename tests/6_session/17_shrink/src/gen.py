@@ -0,0 +1,4 @@
+import random
+random.seed(int(input()))
+for _ in range(random.randint(20, 40)):
+    print(random.randint(1, 60), random.randint(1, 60))
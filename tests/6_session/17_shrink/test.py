@@ -0,0 +1,42 @@
+import subprocess, sys, os, re
+
+
+def run(args):
+    p = subprocess.run(["stress", "-n", "20", "-s", "42", "-c", "gvtp", "-g", "src/gen.py"] + args
+                       + ["src/broken_total.py", "src/total.py"], capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def shrunk(tag):
+    for entry in os.scandir("stress/logs"):
+        if entry.is_file() and entry.name.startswith(tag + "_"):
+            with open(entry.path) as f:
+                return re.findall(r"TEST (\d+) SHRUNK -+\n[^\n]*\n\n(.*?)\s*(?:\n\n|$)", f.read(), re.S)
+    return []
+
+
+for args in [["-tag", "single"], ["-mt", "-w", "4", "-tag", "multi"]]:
+    out = run(["-shrink"] + args)
+    failed = re.search(r"Test (\d+), +Wrong answer", out)
+    logged = shrunk(args[-1])
+
+    # the first failed test is left with a single number which is not counted
+    if not failed or "is shrunk from" not in out or len(logged) != 1 or logged[0][0] != failed.group(1) \
+            or len(logged[0][1].split()) != 1 or int(logged[0][1]) <= 50:
+        sys.stderr.write("test is not shrunk:\n" + out + "\n" + str(logged))
+        exit(1)
+
+# the least 64-bit number has no positive counterpart
+os.makedirs("stress", exist_ok=True)
+with open("stress/least.txt", "w") as f:
+    f.write("-9223372036854775808 70 -9223372036854775808\n")
+
+p = subprocess.run(["stress", "-n", "1", "-f", "stress/least.txt", "-shrink", "-tag", "least", "-c", "tp",
+                    "src/broken_total.py", "src/total.py"], capture_output=True, text=True)
+logged = shrunk("least")
+if p.returncode or len(logged) != 1 or logged[0][1] != "70":
+    sys.stderr.write("test with the least number is not shrunk:\n" + p.stdout + "\n" + str(logged))
+    exit(1)
@@ -0,0 +1,4 @@
+n = int(input())
+a = list(map(int, input().split()))
+assert len(a) == n and all(abs(x) <= 10 ** 9 for x in a)
+print(sum(a))
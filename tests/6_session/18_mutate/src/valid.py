@@ -0,0 +1,5 @@
+import sys
+lines = sys.stdin.read().splitlines()
+n = int(lines[0])
+a = list(map(int, lines[1].split()))
+sys.exit(0 if len(a) == n and all(abs(x) <= 10 ** 9 for x in a) else 1)
@@ -0,0 +1,40 @@
+import subprocess, sys, os, re
+
+
+def run(args):
+    p = subprocess.run(["stress", "-n", "60", "-mt", "-c", "gvtp"] + args
+                       + ["src/strict_sum.py", "src/sum.py"], capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def verdicts(out):
+    return [v for _, v in re.findall(r"Test (\d+), +(.*?) *\n", out)]
+
+
+# changes of the known tests break the solution
+out = run(["-mutate", "src/seeds.txt", "-tag", "mutated"])
+if len(verdicts(out)) != 60 or "Runtime error" not in verdicts(out):
+    sys.stderr.write("tests are not mutated:\n" + out)
+    exit(1)
+
+# invalid tests are dropped by validator
+out = run(["-mutate", "src/seeds.txt", "-validator", "src/valid.py", "-dnl"])
+if verdicts(out) != ["OK"] * 60:
+    sys.stderr.write("tests are not validated:\n" + out)
+    exit(1)
+
+# validator is run within the memory budget
+out = run(["-mutate", "src/seeds.txt", "-validator", "src/valid.py", "-w", "4", "-mem-budget", "256M", "-dnl"])
+if verdicts(out) != ["OK"] * 60:
+    sys.stderr.write("tests are not validated within the budget:\n" + out)
+    exit(1)
+
+# failed tests of the log are mutated as well
+log = [e.path for e in os.scandir("stress/logs") if e.name.startswith("mutated_")][0]
+out = run(["-mutate", log, "-n", "10", "-dnl"])
+if len(verdicts(out)) != 10:
+    sys.stderr.write("logged tests are not mutated:\n" + out)
+    exit(1)
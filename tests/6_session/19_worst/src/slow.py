@@ -0,0 +1,4 @@
+import sys, time
+n = int((sys.stdin.read().split() or ["0"])[0])
+time.sleep(max(0, min(n, 30)) * 0.04)
+print(n)
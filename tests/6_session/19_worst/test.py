@@ -0,0 +1,34 @@
+import subprocess, sys, os, re
+
+
+def run(args):
+    p = subprocess.run(["stress", "-mt", "-c", "gvtp", "-worst", "time"] + args + ["src/slow.py"],
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def worst(tag):
+    for entry in os.scandir("stress/logs"):
+        if entry.is_file() and entry.name.startswith(tag + "_"):
+            with open(entry.path) as f:
+                return [int(n) for n in re.findall(r"TEST \d+ WORST -+\n(?:[^\n]*\n)*?\n(-?\d+)", f.read())]
+    return []
+
+
+# slowest tests are reported in order with their seeds
+out = run(["-g", "src/gen.py", "-n", "20", "-tag", "seeded"])
+reported = re.findall(r"Test (\d+), (\d+) ms, \d+ MB, seed (\d+)\n", out)
+made = [int(subprocess.run(["python3", "src/gen.py"], input=seed, capture_output=True, text=True).stdout)
+        for _, _, seed in reported]
+if len(reported) != 5 or made != worst("seeded") or max(made) - made[0] > 1:
+    sys.stderr.write("slowest tests are not found:\n" + out + "\n" + str(made))
+    exit(1)
+
+# mutations of the slowest tests are made more often, so they get slower
+out = run(["-mutate", "src/seeds.txt", "-n", "60", "-tag", "mutated"])
+if len(worst("mutated")) != 5 or worst("mutated")[0] < 30:
+    sys.stderr.write("mutations are not selected:\n" + out + "\n" + str(worst("mutated")))
+    exit(1)
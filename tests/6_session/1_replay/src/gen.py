@@ -0,0 +1,3 @@
+import random
+random.seed(int(input()))
+print(random.randint(-1000, 1000), random.randint(-1000, 1000))
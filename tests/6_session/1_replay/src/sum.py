@@ -0,0 +1 @@
+print(sum(map(int, input().split())))
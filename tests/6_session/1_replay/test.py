@@ -0,0 +1,41 @@
+import subprocess, sys, os, re
+
+
+def run(args):
+    p = subprocess.run(["stress"] + args + ["-c", "gvtp", "-g", "src/gen.py", "src/broken_sum.py", "src/sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def failures(tag):
+    for entry in os.scandir("stress/logs"):
+        if entry.is_file() and entry.name.startswith(tag + "_"):
+            with open(entry.path) as f:
+                return re.findall(r"TEST (\d+) -+\nseed: (\d+)", f.read())
+    return []
+
+
+run(["-n", "30", "-s", "42", "-tag", "full"])
+full = failures("full")
+
+if len(full) == 0:
+    sys.stderr.write("no failures found")
+    exit(1)
+
+# replay by numbers
+run(["-s", "42", "-replay", ",".join(t for t, _ in full), "-tag", "by_number"])
+
+if failures("by_number") != full:
+    sys.stderr.write("replay by numbers differs:\n" + str(full) + "\n" + str(failures("by_number")))
+    exit(1)
+
+# replay by seeds
+out = run(["-replay", ",".join("s" + s for _, s in full), "-tag", "by_seed"])
+cnt = out.count("Wrong answer")
+
+if cnt != len(full):
+    sys.stderr.write("expected " + str(len(full)) + " WAs, got " + str(cnt))
+    exit(1)
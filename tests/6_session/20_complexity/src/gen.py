@@ -0,0 +1,2 @@
+seed = int(input())
+print(int(input()))
@@ -0,0 +1,3 @@
+import time
+time.sleep((int(input()) / 1600) ** 2 * 0.8)
+print(1)
@@ -0,0 +1,23 @@
+import subprocess, sys, re
+
+
+def run(args):
+    p = subprocess.run(["stress", "-g", "src/gen.py", "-scale", "100-1600", "-n", "2", "-mt", "-c", "gvtp"] + args,
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+# sizes go up twice, each one is run -n times
+out = run(["src/square.py", "src/linear.py"])
+sizes = re.findall(r"^ +(\d+) +\d+ ms", out, re.M)
+estimates = re.findall(r"Time: (.*), memory: (.*)\n", out)
+if len(re.findall(r"Test \d+", out)) != 10 or sizes != ["100", "200", "400", "800", "1600"] * 2:
+    sys.stderr.write("sizes are not passed:\n" + out)
+    exit(1)
+
+if estimates != [("O(n^2)", "O(1)"), ("O(n)", "O(1)")]:
+    sys.stderr.write("complexity is not estimated:\n" + out)
+    exit(1)
@@ -0,0 +1,6 @@
+import time
+n = int(input())
+with open("stress/runs.txt", "a") as f:
+    f.write(str(n) + "\n")
+time.sleep(0.02)
+print(n if n % 5 else -n)
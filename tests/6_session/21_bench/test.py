@@ -0,0 +1,49 @@
+import subprocess, sys, os, re
+
+
+def run(args, code=0):
+    if os.path.exists("stress/runs.txt"):
+        os.remove("stress/runs.txt")
+    p = subprocess.run(["stress", "-g", "src/gen.py", "-c", "gvtp"] + args + ["src/sleepy.py", "src/prime.py"],
+                       capture_output=True, text=True)
+    if p.returncode != code:
+        sys.stderr.write(p.stdout.strip())
+        exit(1)
+    return p.stdout
+
+
+def runs():
+    with open("stress/runs.txt") as f:
+        return [int(n) for n in f.read().split()]
+
+
+def rows(out):
+    return re.findall(r"^(\d+),(\d+),(time_ms|memory_mb),(\d+),(.*)\n", out, re.M)
+
+
+# each accepted test is run with warmups, failed ones are not measured
+out = run(["-n", "8", "-s", "3", "-bench", "3", "-warmup", "2"])
+table = rows(out)
+accepted = len(re.findall(r"Test \d+, OK", out))
+if "test,seed,metric,runs,min,median,p90,p99,mean,stddev,ci95_low,ci95_high" not in out or accepted in (0, 8) \
+        or len(table) != 2 * accepted or len(runs()) != 5 * accepted + 8 - accepted:
+    sys.stderr.write("tests are not benchmarked:\n" + out + "\n" + str(runs()))
+    exit(1)
+
+for test, seed, metric, count, stats in table:
+    low, median, p90, p99, mean, stddev, ci_low, ci_high = map(float, stats.split(","))
+    if count != "3" or not (low <= median <= p90 <= p99 and ci_low <= mean <= ci_high and stddev >= 0) \
+            or (metric == "time_ms" and low < 20):
+        sys.stderr.write("statistics are wrong:\n" + out)
+        exit(1)
+
+# checked run is measured as well without warmups
+out = run(["-n", "8", "-s", "3", "-bench", "3", "-warmup", "0", "-pin", "0"])
+if len(rows(out)) != 2 * accepted or len(runs()) != 3 * accepted + 8 - accepted:
+    sys.stderr.write("checked run is not measured:\n" + out + "\n" + str(runs()))
+    exit(1)
+
+# solution is pinned to a core only while benchmarking
+if "[!]" not in run(["-n", "1", "-pin", "0"], 1) or "[!]" not in run(["-n", "1", "-bench", "2", "-multitest", "2"], 1):
+    sys.stderr.write("options are not checked")
+    exit(1)
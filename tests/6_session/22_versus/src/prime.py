@@ -0,0 +1 @@
+print(int(input()) * 2)
@@ -0,0 +1,4 @@
+import time
+n = int(input())
+time.sleep(0.3)
+print(n * 2)
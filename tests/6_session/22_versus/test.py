@@ -0,0 +1,27 @@
+import subprocess, sys, re
+
+
+def run(args, code=0):
+    p = subprocess.run(["stress", "-g", "src/gen.py", "-c", "gvtp"] + args, capture_output=True, text=True)
+    if p.returncode != code:
+        sys.stderr.write(p.stdout.strip())
+        exit(1)
+    return p.stdout
+
+
+# variants are run on the same tests and checked by prime
+out = run(["-n", "8", "-s", "5", "-mt", "-vs", "src/slow.py", "-vs", "src/fast.py", "-vs", "src/wrong.py",
+           "src/solution.py", "src/prime.py"])
+rows = re.findall(r"^ +\d+ +\d+ ms +([\d.]+x) +([\d.]+x) +([\d.]+x|WA)\n", out, re.M)
+ranking = re.findall(r"^\d\. (\S+) +(.*)\n", out, re.M)
+if len(rows) != 8 or not any(r[2] == "WA" for r in rows) or [name for name, _ in ranking][2:] != ["solution.py", "slow.py"] \
+        or not re.match(r"0\.\d+x, 8 wins, 0 losses, 0 ties, p = 0\.0\d+", dict(ranking)["fast.py"]) \
+        or not re.match(r"[\d.]+x, 0 wins, 8 losses, 0 ties, p = 0\.0\d+", dict(ranking)["slow.py"]) \
+        or not re.search(r"Wrong answer of wrong.py on \d+ tests, the first is test \d+\n", out):
+    sys.stderr.write("variants are not ranked:\n" + out)
+    exit(1)
+
+# outputs of variants must be checked
+if "[!]" not in run(["-n", "1", "-vs", "src/fast.py", "src/solution.py"], 1):
+    sys.stderr.write("variants are compared without prime")
+    exit(1)
@@ -0,0 +1,4 @@
+import time
+n = int(input())
+time.sleep(0.1)
+print(n * 2)
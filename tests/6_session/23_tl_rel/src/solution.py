@@ -0,0 +1,5 @@
+import time
+n = int(input())
+# much slower than prime on even tests, and faster on odd ones
+time.sleep(0.5 if n % 2 == 0 else 0)
+print(n * 2)
@@ -0,0 +1,52 @@
+import subprocess, sys, os, re
+
+
+def run(args, code=None):
+    p = subprocess.run(["stress", "-g", "src/gen.py", "-c", "gvtp", "-n", "6", "-s", "7"] + args,
+                       capture_output=True, text=True)
+    if code is not None and p.returncode != code:
+        sys.stderr.write(p.stdout.strip())
+        exit(1)
+    return p.stdout
+
+
+def tests(out):
+    return [(verdict, float(ratio), int(tl)) for verdict, ratio, tl in
+            re.findall(r"Test \d+, +(OK|Time limit exceeded) +\d+ ms, \d+ MB, ([\d.]+)x of prime, TL (\d+) ms", out)]
+
+
+def fail(message, out):
+    sys.stderr.write(message + ":\n" + out)
+    exit(1)
+
+
+# prime is run first, so the limit of each test is known
+out = run(["-tl-rel", "2x", "-tl-floor", "10", "-tag", "rel", "src/solution.py", "src/prime.py"])
+verdicts = tests(out)
+if len(verdicts) != 6 or any(tl < 200 or (verdict == "OK") != (ratio < 2) for verdict, ratio, tl in verdicts) \
+        or {verdict for verdict, _, _ in verdicts} != {"OK", "Time limit exceeded"}:
+    fail("time limit is not relative to prime", out)
+
+log = ""
+for entry in os.scandir("stress/logs"):
+    if entry.name.startswith("rel_"):
+        with open(entry.path) as f:
+            log = f.read()
+if not re.search(r"verdict: TL, \d+ ms, [\d.]+ MB, [\d.]+x of prime, TL \d+ ms\n", log):
+    fail("ratio is not logged", log)
+
+# limit is not less than the floor and not more than the absolute one
+out = run(["-tl-rel", "2x", "-tl-floor", "2000", "src/solution.py", "src/prime.py"], 0)
+if [tl for _, _, tl in tests(out)] != [2000] * 6:
+    fail("floor is not applied", out)
+
+out = run(["-tl-rel", "100x", "-tl", "300", "src/solution.py", "src/prime.py"])
+if [tl for _, _, tl in tests(out)] != [300] * 6:
+    fail("cap is not applied", out)
+
+if "[!]" not in run(["-tl-rel", "2x", "src/solution.py"], 1):
+    fail("time limit is relative without prime", "")
+
+for ratio in ["3xyz", "2y", "x"]:
+    if "Expected a positive ratio" not in run(["-tl-rel", ratio, "src/solution.py", "src/prime.py"], 1):
+        fail("ratio " + ratio + " is accepted", "")
@@ -0,0 +1 @@
+print(input().split()[0])
@@ -0,0 +1,4 @@
+import time
+n = int(input().split()[0])
+time.sleep(0.01 * n)
+print(n)
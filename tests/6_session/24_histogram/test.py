@@ -0,0 +1,53 @@
+import subprocess, sys, os, re
+
+
+def run(args):
+    p = subprocess.run(["stress", "-g", "src/gen.py", "-mt", "-st", "-c", "gvtp", "-n", "30"] + args,
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def fail(message, out):
+    sys.stderr.write(message + ":\n" + out)
+    exit(1)
+
+
+def made(seed):
+    return int(subprocess.run(["python3", "src/gen.py"], input=seed, capture_output=True, text=True).stdout)
+
+
+# each unit has histograms of time and memory with percentiles
+out = run(["-tag", "stats", "src/slow.py", "src/prime.py"])
+titles = re.findall(r"\[\*\] (Time|Memory) of (solution to test|prime solution):\n", out)
+if titles != [("Time", "solution to test"), ("Memory", "solution to test"),
+              ("Time", "prime solution"), ("Memory", "prime solution")]:
+    fail("histograms are not shown", out)
+
+times = out.split("[*] Time of solution to test:\n")[1].split("\n\n")[0].split("\n")
+percentiles = [int(v) for v in re.findall(r"p[\d.]+ (\d+) ms, ", times[0])]
+counts = [int(row.split()[2]) for row in times[1:]]
+if len(percentiles) != 4 or percentiles != sorted(percentiles) or sum(counts) != 30:
+    fail("time of solution is not counted", out)
+
+# leaderboards are ordered and have seeds
+slowest = re.findall(r"Test \d+, (\d+) ms, \d+ MB, seed (\d+)\n",
+                     out.split("[*] Slowest tests:\n")[1].split("\n\n")[0] + "\n")
+ns = [made(seed) for _, seed in slowest]
+if len(slowest) != 10 or max(ns) - ns[0] > 3 or "[*] Tests with most memory:" not in out:
+    fail("slowest tests are not found", out + "\n" + str(ns))
+
+log = ""
+for entry in os.scandir("stress/logs"):
+    if entry.name.startswith("stats_"):
+        with open(entry.path) as f:
+            log = f.read()
+if len(re.findall(r"TEST \d+ WORST", log)) != 20:
+    fail("leaderboards are not logged", log)
+
+# grouped tests are timed only together
+out = run(["-multitest", "10", "src/slow.py"])
+if "[*] Time of solution" in out or "[*] Slowest tests" in out:
+    fail("grouped tests have histograms", out)
@@ -0,0 +1,58 @@
+import subprocess, sys, os, re
+
+prefix = "../1_replay/src/"
+
+
+def run(args):
+    p = subprocess.run(["stress"] + args + ["-c", "gvtp", "-g", prefix + "gen.py",
+                                            prefix + "broken_sum.py", prefix + "sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def failures(tag):
+    for entry in os.scandir("stress/logs"):
+        if entry.is_file() and entry.name.startswith(tag + "_"):
+            with open(entry.path) as f:
+                return re.findall(r"TEST (\d+) -+\nseed: (\d+)", f.read())
+    return []
+
+
+def tests(out):
+    return re.findall(r"Test (\d+), +(.*?) *\n", out)
+
+
+full = tests(run(["-n", "30", "-s", "42", "-tag", "full"]))
+shards = []
+shard_failures = []
+
+for i in range(1, 4):
+    shards += tests(run(["-n", "30", "-s", "42", "-shard", str(i) + "/3", "-tag", "shard" + str(i)]))
+    shard_failures += failures("shard" + str(i))
+
+if len(full) != 30 or sorted(full) != sorted(shards):
+    sys.stderr.write("shards don't cover all the tests:\n" + str(full) + "\n" + str(shards))
+    exit(1)
+
+if sorted(failures("full")) != sorted(shard_failures):
+    sys.stderr.write("shards have different failures")
+    exit(1)
+
+# shards may get no tests at all
+out = run(["-n", "2", "-shard", "3/3", "-st", "-mt", "-tag", "empty"])
+if tests(out) or "Stress-testing is over" not in out:
+    sys.stderr.write("empty shard failed:\n" + out)
+    exit(1)
+
+os.makedirs("stress", exist_ok=True)
+with open("stress/two.txt", "w") as f:
+    f.write("1 2\n\n3 4\n")
+
+p = subprocess.run(["stress", "-f", "stress/two.txt", "-n", "5", "-shard", "3/3", "-st", "-c", "tp",
+                    prefix + "sum.py"], capture_output=True, text=True)
+if p.returncode or tests(p.stdout) or "Stress-testing is over" not in p.stdout:
+    sys.stderr.write("empty shard of tests file failed:\n" + p.stdout)
+    exit(1)
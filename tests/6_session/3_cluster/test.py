@@ -0,0 +1,68 @@
+import subprocess, sys, os, re, time
+
+prefix = "../1_replay/src/"
+units = ["-c", "gvtp", "-g", prefix + "gen.py", prefix + "broken_sum.py", prefix + "sum.py"]
+address = "unix:" + os.path.abspath("stress.sock")
+
+
+def tests(out):
+    return re.findall(r"Test (\d+), +(.*?) *\n", out)
+
+
+local = subprocess.run(["stress", "-n", "20", "-s", "42"] + units, capture_output=True, text=True)
+
+if local.returncode:
+    sys.stderr.write(local.stdout.strip())
+    exit(local.returncode)
+
+def cluster(args, units=units, worker_args=()):
+    coordinator = subprocess.Popen(["stress", "-serve", address, "-n", "20", "-s", "42"] + args + units,
+                                   stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+
+    # wait for socket to be created
+    for i in range(100):
+        if os.path.exists("stress.sock"):
+            break
+        time.sleep(0.05)
+
+    workers = [subprocess.Popen(["stress", "-join", address] + w + list(worker_args) + units,
+                                stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+               for w in (["-mt", "-w", "2"], [])]
+
+    for w in workers:
+        out, _ = w.communicate(timeout=120)
+        if w.returncode:
+            sys.stderr.write(out.strip())
+            exit(w.returncode)
+
+    out, _ = coordinator.communicate(timeout=120)
+
+    if coordinator.returncode:
+        sys.stderr.write(out.strip())
+        exit(coordinator.returncode)
+    return out
+
+
+out = cluster([])
+if tests(out) != tests(local.stdout) or len(tests(out)) != 20:
+    sys.stderr.write("cluster results differ from local ones:\n" + out + "\n" + local.stdout)
+    exit(1)
+
+# inputs of the slowest tests are sent by workers to be logged
+out = cluster(["-st", "-tag", "leaders"])
+log = ""
+for entry in os.scandir("stress/logs"):
+    if entry.name.startswith("leaders_"):
+        with open(entry.path) as f:
+            log = f.read()
+inputs = re.findall(r"TEST \d+ WORST -+\nseed: \d+\nverdict: [^\n]*\n\n([^\n]*)", log)
+if len(inputs) != 2 * 10 or not all(inputs):
+    sys.stderr.write("slowest tests are logged without inputs:\n" + out + "\n" + log)
+    exit(1)
+
+# time limits relative to prime are shown by coordinator
+rel = ["-c", "gvtp", "-g", "../23_tl_rel/src/gen.py", "../23_tl_rel/src/solution.py", "../23_tl_rel/src/prime.py"]
+out = cluster(["-tl-rel", "2x", "-tl-floor", "10"], rel, ["-tl-rel", "2x", "-tl-floor", "10"])
+if len(re.findall(r"x of prime, TL \d+ ms", out)) != 20:
+    sys.stderr.write("relative time limits are not sent by workers:\n" + out)
+    exit(1)
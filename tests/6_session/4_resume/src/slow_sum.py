@@ -0,0 +1,5 @@
+import time
+
+time.sleep(0.3)
+a, b = map(int, input().split())
+print(a + b if a % 3 else 0)
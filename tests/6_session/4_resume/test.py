@@ -0,0 +1,44 @@
+import subprocess, signal, sys, os, re, time
+
+prefix = "../1_replay/src/"
+args = ["-n", "30", "-s", "42", "-c", "gvtp", "-g", prefix + "gen.py", "src/slow_sum.py", prefix + "sum.py"]
+
+
+def tests(out):
+    return re.findall(r"Test (\d+), +(.*?) *\n", out)
+
+
+def failures():
+    for entry in os.scandir("stress/logs"):
+        with open(entry.path) as f:
+            return re.findall(r"TEST (\d+) -+\nseed: (\d+)", f.read())
+    return []
+
+
+full = subprocess.run(["stress", "-dnl"] + args, capture_output=True, text=True).stdout
+
+# interrupt as ctrl+c does
+p = subprocess.Popen(["stress"] + args, stdout=subprocess.PIPE, text=True)
+time.sleep(3)
+p.send_signal(signal.SIGINT)
+first = p.communicate()[0]
+
+if not os.path.exists("stress/checkpoints/slow_sum.txt"):
+    sys.stderr.write("checkpoint is not stored:\n" + first)
+    exit(1)
+
+second = subprocess.run(["stress", "-resume"] + args, capture_output=True, text=True).stdout
+
+if os.path.exists("stress/checkpoints/slow_sum.txt"):
+    sys.stderr.write("checkpoint is not removed after the session is done")
+    exit(1)
+
+done = [t for t in tests(first) if t[1] != "Interrupted"] + tests(second)
+
+if done != tests(full):
+    sys.stderr.write("resumed session differs:\n" + str(done) + "\n" + str(tests(full)))
+    exit(1)
+
+if [int(t) for t, _ in failures()] != [int(t) for t, v in tests(full) if v != "OK"]:
+    sys.stderr.write("log of resumed session differs")
+    exit(1)
@@ -0,0 +1,9 @@
+import os, time
+
+# fails if another instance is running
+fd = os.open("running.lock", os.O_CREAT | os.O_EXCL)
+time.sleep(0.1)
+a, b = map(int, input().split())
+os.close(fd)
+os.remove("running.lock")
+print(a + b)
@@ -0,0 +1,34 @@
+import subprocess, sys
+
+prefix = "../1_replay/src/"
+
+
+def run(args):
+    p = subprocess.run(["stress", "-mt", "-n", "12", "-ml", "64"] + args +
+                       ["-c", "gvtp", "-g", prefix + "gen.py", "src/exclusive_sum.py", prefix + "sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+# workers count is derived from the budget
+out = run(["-mem-budget", "100M"])
+if "[*] Workers count: 1\n" not in out:
+    sys.stderr.write("workers count is not derived from the budget:\n" + out)
+    exit(1)
+
+# explicit workers wait for the memory
+out = run(["-w", "4", "-mem-budget", "64M"])
+if "Solution is correct" not in out:
+    sys.stderr.write("solutions were run at once:\n" + out)
+    exit(1)
+
+# only a number with an optional suffix is a size
+for size in ["32GBx", "64Mb", "1Q", "M"]:
+    p = subprocess.run(["stress", "-mem-budget", size, "-g", prefix + "gen.py", prefix + "sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode == 0 or "Expected a size" not in p.stdout:
+        sys.stderr.write("size " + size + " is accepted:\n" + p.stdout)
+        exit(1)
@@ -0,0 +1,22 @@
+import subprocess, sys, re, os
+
+# tests separated by LF, CRLF and CR line breaks
+tests = "\n\n1 2\n\n\n3 4\r\n\r\n5 6\r\r7\n8\n\n" + "9 10" * 5000 + "\n"
+
+# kept in ./stress to be cleaned up
+os.makedirs("stress", exist_ok=True)
+
+with open("stress/tests.txt", "w", newline="") as f:
+    f.write(tests)
+
+p = subprocess.run(["stress", "-mt", "-n", "100", "-f", "stress/tests.txt", "-c", "tp",
+                    "../1_replay/src/sum.py", "../1_replay/src/sum.py"],
+                   capture_output=True, text=True)
+
+found = re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+verdicts = [v for _, v in found]
+
+# the fourth test has two lines, so sum.py reads only the first one
+if [int(t) for t, _ in found] != [1, 2, 3, 4, 5] or verdicts[:4] != ["OK"] * 4:
+    sys.stderr.write(p.stdout)
+    exit(1)
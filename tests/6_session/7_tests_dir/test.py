@@ -0,0 +1,22 @@
+import subprocess, sys, re, os
+
+# natural order: t2 goes before t10, t010 is the same number as t10
+# tests are kept in ./stress to be cleaned up
+os.makedirs("stress/tests", exist_ok=True)
+names = ["t" + str(i) for i in range(1, 10)] + ["t010", "t11", "t12"]
+
+for i, name in enumerate(names, 1):
+    with open(os.path.join("stress/tests", name + ".txt"), "w") as f:
+        f.write(str(i) + " 1\n")
+
+p = subprocess.run(["stress", "-mt", "-n", "20", "-d", "stress/tests", "-c", "tp",
+                    "../1_replay/src/broken_sum.py", "../1_replay/src/sum.py"],
+                   capture_output=True, text=True)
+
+found = re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+failed = [int(t) for t, v in found if v != "OK"]
+
+# broken_sum.py fails if the first number is divisible by 3
+if len(found) != 12 or failed != [3, 6, 9, 12]:
+    sys.stderr.write(p.stdout)
+    exit(1)
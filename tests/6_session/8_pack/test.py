@@ -0,0 +1,52 @@
+import subprocess, sys, os, re
+
+prefix = "../1_replay/src/"
+
+
+def run(args):
+    p = subprocess.run(["stress", "-mt", "-c", "gvtp"] + args + [prefix + "broken_sum.py", prefix + "sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return p.stdout
+
+
+def tests(out):
+    return re.findall(r"Test (\d+), +(.*?) *\n", out)
+
+
+def failures(tag):
+    for entry in os.scandir("stress/logs"):
+        if entry.is_file() and entry.name.startswith(tag + "_"):
+            with open(entry.path) as f:
+                return re.findall(r"TEST (\d+) -+\nseed: (\d+)\n(?:.*\n)*?\n(.*)\n", f.read())
+    return []
+
+
+os.makedirs("stress", exist_ok=True)
+recorded = run(["-n", "30", "-s", "42", "-g", prefix + "gen.py", "-record", "stress/tests.pack", "-tag", "record"])
+
+# the pack is the only source, generator is not needed anymore
+replayed = run(["-n", "100", "-pack", "stress/tests.pack", "-tag", "pack"])
+
+if len(tests(recorded)) != 30 or tests(recorded) != tests(replayed):
+    sys.stderr.write("pack differs from recorded tests:\n" + recorded + "\n" + replayed)
+    exit(1)
+
+# the pack tells which generator made it
+made = re.findall(r"Recording tests of generator ([0-9a-f]{16})", recorded)
+if not made or made != re.findall(r"Pack of 30 tests of generator ([0-9a-f]{16})", replayed):
+    sys.stderr.write("generator of the pack is not shown:\n" + recorded + "\n" + replayed)
+    exit(1)
+
+# failed tests have the same numbers, seeds and inputs
+if not failures("record") or failures("record") != failures("pack"):
+    sys.stderr.write("logs differ")
+    exit(1)
+
+# tests are taken by position in the pack
+part = run(["-pack", "stress/tests.pack", "-replay", ",".join(t for t, _, _ in failures("record"))])
+if len(tests(part)) != len(failures("record")) or any(v == "OK" for _, v in tests(part)):
+    sys.stderr.write("replay from pack failed:\n" + part)
+    exit(1)
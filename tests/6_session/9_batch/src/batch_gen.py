@@ -0,0 +1,8 @@
+import random
+
+# the same tests as ../1_replay/src/gen.py makes one by one
+k = int(input())
+for _ in range(k):
+    random.seed(int(input()))
+    print(random.randint(-1000, 1000), random.randint(-1000, 1000))
+    print("\x1e")
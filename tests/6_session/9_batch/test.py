@@ -0,0 +1,30 @@
+import subprocess, sys, re
+
+prefix = "../1_replay/src/"
+
+
+def run(args):
+    p = subprocess.run(["stress", "-n", "30", "-s", "42", "-c", "gvtp"] + args +
+                       [prefix + "broken_sum.py", prefix + "sum.py"],
+                       capture_output=True, text=True)
+    if p.returncode:
+        sys.stderr.write(p.stdout.strip())
+        exit(p.returncode)
+    return re.findall(r"Test (\d+), +(.*?) *\n", p.stdout)
+
+
+single = run(["-g", prefix + "gen.py"])
+batched = run(["-mt", "-batch", "7", "-g", "src/batch_gen.py"])
+
+# each test has the same seed as if it was made alone
+if len(single) != 30 or single != batched:
+    sys.stderr.write("batches differ:\n" + str(single) + "\n" + str(batched))
+    exit(1)
+
+# a test of batch is replayed alone
+failed = [t for t, v in single if v != "OK"]
+replayed = run(["-batch", "7", "-g", "src/batch_gen.py", "-replay", failed[-1]])
+
+if replayed != [(failed[-1], "Wrong answer")]:
+    sys.stderr.write("replay failed:\n" + str(replayed))
+    exit(1)